@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================================
+// Adafruit_GFX - Примітиви та класичний шрифт 5x7, як у бібліотеці Adafruit
+// ============================================================================
+// Порядок викликів збігається з оригіналом: гліф масштабу 1 малюється
+// writePixel(), більшого — writeFillRect() на кожен піксель шрифту. Тому
+// лічильники дисплея показують ту саму кількість вікон і пікселів, що
+// пішла б по SPI на пристрої
+class Adafruit_GFX : public Print {
+protected:
+    const int16_t WIDTH;
+    const int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x = 0;
+    int16_t cursor_y = 0;
+    uint16_t textcolor = 0xFFFF;
+    uint16_t textbgcolor = 0xFFFF;
+    uint8_t textsize_x = 1;
+    uint8_t textsize_y = 1;
+    uint8_t rotation = 0;
+    bool wrap = true;
+    
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+    
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    
+    virtual void startWrite() {}
+    virtual void endWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { writeFillRect(x, y, w, 1, color); }
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { writeFillRect(x, y, 1, h, color); }
+    
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
+    
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+    size_t write(uint8_t c) override;
+    using Print::write;
+    
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t color) { textcolor = textbgcolor = color; }
+    void setTextColor(uint16_t color, uint16_t background) { textcolor = color; textbgcolor = background; }
+    void setTextSize(uint8_t size) { textsize_x = textsize_y = size > 0 ? size : 1; }
+    void setTextWrap(bool wrap) { this->wrap = wrap; }
+    virtual void setRotation(uint8_t rotation);
+    
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    uint8_t getRotation() const { return rotation; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+};
+
+class GFXcanvas1 : public Adafruit_GFX {
+private:
+    uint8_t* buffer;
+    
+public:
+    GFXcanvas1(uint16_t w, uint16_t h);
+    ~GFXcanvas1();
+    
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y) const;
+    uint8_t* getBuffer() const { return buffer; }
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+private:
+    uint16_t* buffer;
+    
+public:
+    GFXcanvas16(uint16_t w, uint16_t h);
+    ~GFXcanvas16();
+    
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    uint16_t getPixel(int16_t x, int16_t y) const;
+    uint16_t* getBuffer() const { return buffer; }
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+// ============================================================================
+// Adafruit_ILI9341 - Кадровий буфер у пам'яті замість панелі
+// ============================================================================
+// Кожне адресне вікно та кожен переданий піксель рахуються так, як їх
+// передав би драйвер по SPI. Вміст можна зберегти в PPM (--framebuffer)
+// для порівняння екранів між збірками
+#define ILI9341_TFTWIDTH 240
+#define ILI9341_TFTHEIGHT 320
+
+#define ILI9341_BLACK 0x0000
+#define ILI9341_NAVY 0x000F
+#define ILI9341_DARKGREEN 0x03E0
+#define ILI9341_DARKGREY 0x7BEF
+#define ILI9341_LIGHTGREY 0xC618
+#define ILI9341_BLUE 0x001F
+#define ILI9341_GREEN 0x07E0
+#define ILI9341_CYAN 0x07FF
+#define ILI9341_RED 0xF800
+#define ILI9341_MAGENTA 0xF81F
+#define ILI9341_YELLOW 0xFFE0
+#define ILI9341_WHITE 0xFFFF
+#define ILI9341_ORANGE 0xFD20
+
+class Adafruit_SPITFT : public Adafruit_GFX {
+private:
+    uint16_t* framebuffer;
+    int16_t windowX = 0;
+    int16_t windowY = 0;
+    int16_t windowWidth = 0;
+    int16_t windowHeight = 0;
+    uint32_t windowOffset = 0;
+    uint32_t windows = 0;
+    uint64_t pixels = 0;
+    
+    void storePixel(int16_t x, int16_t y, uint16_t color);
+    
+public:
+    Adafruit_SPITFT(int16_t w, int16_t h);
+    ~Adafruit_SPITFT();
+    
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void writePixels(uint16_t* colors, uint32_t length, bool block = true, bool bigEndian = false);
+    void writeColor(uint16_t color, uint32_t length);
+    void dmaWait() {}
+    
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    
+    // Колір у координатах після повороту
+    uint16_t getPixel(int16_t x, int16_t y) const;
+    uint32_t getWindowCount() const { return windows; }
+    uint64_t getPixelCount() const { return pixels; }
+    bool savePpm(const char* path) const;
+};
+
+class Adafruit_ILI9341 : public Adafruit_SPITFT {
+public:
+    Adafruit_ILI9341(int8_t cs, int8_t dc, int8_t rst = -1)
+        : Adafruit_SPITFT(ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT) {}
+    
+    void begin(uint32_t freq = 0);
+};
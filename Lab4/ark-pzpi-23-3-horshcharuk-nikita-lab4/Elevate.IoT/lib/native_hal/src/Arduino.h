@@ -0,0 +1,226 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+// ============================================================================
+// Arduino - Хостова реалізація підмножини Arduino-ESP32 для env:native
+// ============================================================================
+// Модулі прошивки звертаються до заліза лише через API Arduino, тож саме
+// він і є шаром абстракції: на пристрої його дає фреймворк, а тут — ця
+// бібліотека. Реалізовано тільки те, що викликає прошивка
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define ONLOW 0x04
+#define ONHIGH 0x05
+#define ONLOW_WE 0x0C  // рівень і заразом пробудження з light sleep
+#define ONHIGH_WE 0x0D
+
+#define DEC 10
+#define HEX 16
+
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// Кнопки під'єднані з підтяжкою, тож непідключений вхід читається як HIGH
+void pinMode(int pin, int mode);
+int digitalRead(int pin);
+void digitalWrite(int pin, int value);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(int interrupt, void (*handler)(), int mode);
+void attachInterruptArg(int interrupt, void (*handler)(void*), void* arg, int mode);
+void detachInterrupt(int interrupt);
+
+// Генератор детермінований (--seed), щоб прогони можна було повторити
+uint32_t esp_random();
+long random(long maxValue);
+long random(long minValue, long maxValue);
+
+class Print {
+public:
+    virtual ~Print() {}
+    
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* text) { return text != nullptr ? write((const uint8_t*)text, strlen(text)) : 0; }
+    
+    size_t print(const char* text) { return write(text); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    
+    size_t println() { return write("\r\n"); }
+    size_t println(const char* text) { return print(text) + println(); }
+    size_t println(int value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(unsigned long value, int base = DEC) { return print(value, base) + println(); }
+    
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+protected:
+    unsigned long _timeout = 1000;
+    
+    int timedRead();
+    
+    // Блокує до появи даних або до тайм-ауту; на пристрої Stream
+    // опитує read() у циклі, тут сокет чекає в poll()
+    virtual bool waitAvailable(unsigned long timeoutMs);
+    
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    
+    void setTimeout(unsigned long timeoutMs) { _timeout = timeoutMs; }
+    unsigned long getTimeout() const { return _timeout; }
+    
+    size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+};
+
+// String тримається на std::string: на хості купа не обмежена,
+// тож поведінка при нестачі пам'яті не відтворюється
+class String {
+private:
+    std::string value;
+    
+public:
+    String(const char* text = "") : value(text != nullptr ? text : "") {}
+    String(const std::string& text) : value(text) {}
+    explicit String(char c) : value(1, c) {}
+    explicit String(int number, unsigned char base = DEC);
+    explicit String(unsigned int number, unsigned char base = DEC);
+    explicit String(long number, unsigned char base = DEC);
+    explicit String(unsigned long number, unsigned char base = DEC);
+    
+    unsigned int length() const { return (unsigned int)value.size(); }
+    const char* c_str() const { return value.c_str(); }
+    bool isEmpty() const { return value.empty(); }
+    bool reserve(unsigned int size) { value.reserve(size); return true; }
+    
+    bool concat(const char* text) { value += text != nullptr ? text : ""; return true; }
+    String& operator+=(const String& other) { value += other.value; return *this; }
+    String& operator+=(const char* text) { concat(text); return *this; }
+    String& operator+=(char c) { value += c; return *this; }
+    
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const char* text, unsigned int from = 0) const;
+    int indexOf(const String& text, unsigned int from = 0) const { return indexOf(text.c_str(), from); }
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    
+    bool equals(const String& other) const { return value == other.value; }
+    bool equalsIgnoreCase(const String& other) const;
+    bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+    
+    void trim();
+    void toLowerCase();
+    long toInt() const { return atol(value.c_str()); }
+    
+    char operator[](unsigned int index) const { return index < value.size() ? value[index] : '\0'; }
+    bool operator==(const String& other) const { return value == other.value; }
+    bool operator==(const char* text) const { return value == (text != nullptr ? text : ""); }
+    bool operator!=(const String& other) const { return !(*this == other); }
+    bool operator!=(const char* text) const { return !(*this == text); }
+    
+    friend String operator+(const String& left, const String& right) { return String(left.value + right.value); }
+    friend String operator+(const String& left, const char* right) { return String(left.value + (right != nullptr ? right : "")); }
+    friend String operator+(const char* left, const String& right) { return String(std::string(left != nullptr ? left : "") + right.value); }
+    friend String operator+(const String& left, char right) { return String(left.value + right); }
+};
+
+// Serial пише в stdout, а читає stdin без блокування
+class HardwareSerial : public Stream {
+public:
+    typedef void (*OnReceiveCb)();
+    
+    void begin(unsigned long baud) {}
+    void end() {}
+    
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    
+    // Після першого виклику stdin читає окремий потік, як драйвер UART:
+    // дані складаються в буфер, а обробник викликається на кожну порцію
+    void onReceive(OnReceiveCb callback, bool onlyOnTimeout = false);
+    
+    operator bool() const { return true; }
+    
+private:
+    int peeked = -1;
+};
+
+extern HardwareSerial Serial;
+
+class IPAddress {
+private:
+    uint32_t address; // порядок байтів як у lwIP: перший октет — молодший
+    
+public:
+    IPAddress() : address(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : address((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t value) : address(value) {}
+    
+    operator uint32_t() const { return address; }
+    uint8_t operator[](int index) const { return (address >> (index * 8)) & 0xFF; }
+    bool operator==(const IPAddress& other) const { return address == other.address; }
+    
+    String toString() const;
+    bool fromString(const char* text);
+};
+
+// Купа імітує ESP32: стартовий об'єм мінус те, що зараз виділено malloc
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    void restart();
+};
+
+extern EspClass ESP;
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+
+// ============================================================================
+// FS - Файли в каталозі хоста замість розділу флешу
+// ============================================================================
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+// Копії File ділять один дескриптор, як і на пристрої
+class File : public Stream {
+private:
+    std::shared_ptr<FILE> handle;
+    
+public:
+    File() {}
+    explicit File(FILE* file);
+    
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    size_t read(uint8_t* buffer, size_t size);
+    
+    bool seek(uint32_t position, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close() { handle.reset(); }
+    
+    operator bool() const { return handle != nullptr; }
+};
+
+class FS {
+protected:
+    std::string root;
+    
+    std::string resolve(const char* path) const { return root + path; }
+    
+public:
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool rename(const char* from, const char* to);
+};
+
+}
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <vector>
+
+// ============================================================================
+// HTTPClient - HTTP/1.1 поверх WiFiClient з тими ж кодами, що й в Arduino-ESP32
+// ============================================================================
+// Поведінка повторює бібліотеку пристрою в тому, що помітно прошивці:
+// keep-alive через setReuse(), від'ємні коди помилок транспорту, тіло
+// відповіді читається прямо з getStream(). Перенаправлення не виконуються
+// автоматично; https не підтримується
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_MOVED_PERMANENTLY = 301,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_TEMPORARY_REDIRECT = 307,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_METHOD_NOT_ALLOWED = 405,
+    HTTP_CODE_NOT_ACCEPTABLE = 406,
+    HTTP_CODE_UNSUPPORTED_MEDIA_TYPE = 415,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_NOT_IMPLEMENTED = 501,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503
+} t_http_codes;
+
+class HTTPClient {
+private:
+    struct Header {
+        String key;
+        String value;
+    };
+    
+    WiFiClient ownClient;
+    WiFiClient* client = nullptr;
+    String host;
+    uint16_t port = 80;
+    String uri;
+    bool reuse = true;
+    bool canReuse = false;
+    uint16_t timeoutMs = 5000;
+    
+    String requestHeaders;
+    std::vector<Header> collected;
+    int size = -1;
+    
+    bool parseUrl(const String& url);
+    bool connect();
+    bool readLine(String& line);
+    int handleHeaderResponse();
+    
+public:
+    HTTPClient() {}
+    ~HTTPClient() { end(); }
+    
+    bool begin(WiFiClient& client, const String& url);
+    bool begin(const String& url);
+    void end();
+    bool connected();
+    
+    void setReuse(bool reuse) { this->reuse = reuse; }
+    void setTimeout(uint16_t timeoutMs) { this->timeoutMs = timeoutMs; }
+    
+    void addHeader(const String& name, const String& value, bool first = false, bool replace = true);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    bool hasHeader(const char* name);
+    
+    int GET();
+    int POST(uint8_t* payload, size_t size);
+    int POST(const String& payload) { return POST((uint8_t*)payload.c_str(), payload.length()); }
+    int sendRequest(const char* type, uint8_t* payload = nullptr, size_t size = 0);
+    
+    int getSize() { return size; }
+    WiFiClient& getStream() { return *client; }
+    WiFiClient* getStreamPtr() { return client; }
+    
+    static String errorToString(int error);
+};
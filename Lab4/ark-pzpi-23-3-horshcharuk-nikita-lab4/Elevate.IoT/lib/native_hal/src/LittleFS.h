@@ -0,0 +1,17 @@
+#pragma once
+
+#include "FS.h"
+
+namespace fs {
+
+// Корінь — --fs <каталог> або новий тимчасовий каталог на кожен прогін
+class LittleFSFS : public FS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char* partitionLabel = "spiffs");
+    void end() {}
+};
+
+}
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================================
+// MFRC522 - Відсутній зчитувач
+// ============================================================================
+// VersionReg читається як 0x00, тож прошивка працює лише з кнопками,
+// як на платі без модуля RFID
+class MFRC522 {
+public:
+    enum PCD_Register : byte {
+        CommandReg = 0x01 << 1,
+        ComIEnReg = 0x02 << 1,
+        DivIEnReg = 0x03 << 1,
+        ComIrqReg = 0x04 << 1,
+        FIFODataReg = 0x09 << 1,
+        BitFramingReg = 0x0D << 1,
+        VersionReg = 0x37 << 1
+    };
+    
+    enum PCD_Command : byte {
+        PCD_Idle = 0x00,
+        PCD_Transceive = 0x0C
+    };
+    
+    enum PICC_Command : byte {
+        PICC_CMD_REQA = 0x26
+    };
+    
+    enum StatusCode : byte {
+        STATUS_OK,
+        STATUS_TIMEOUT
+    };
+    
+    typedef struct {
+        byte size;
+        byte uidByte[10];
+        byte sak;
+    } Uid;
+    
+    Uid uid;
+    
+    MFRC522(byte chipSelectPin, byte resetPowerDownPin) : uid() {}
+    
+    void PCD_Init() {}
+    byte PCD_ReadRegister(PCD_Register reg) { return 0x00; }
+    void PCD_WriteRegister(PCD_Register reg, byte value) {}
+    bool PICC_IsNewCardPresent() { return false; }
+    bool PICC_ReadCardSerial() { return false; }
+    StatusCode PICC_HaltA() { return STATUS_TIMEOUT; }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================================
+// Preferences - NVS у пам'яті процесу
+// ============================================================================
+// Кожен прогін починає з чистого NVS, як щойно прошитий пристрій, тож
+// заміри не залежать від попередніх запусків. Ключі зберігаються як байти
+// разом із типом, і читання іншим типом повертає значення за замовчуванням
+class Preferences {
+private:
+    void* space = nullptr;
+    bool readOnly = false;
+    
+    size_t putValue(const char* key, uint8_t type, const void* value, size_t length);
+    size_t getValue(const char* key, uint8_t type, void* value, size_t length);
+    
+public:
+    bool begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+    void end();
+    
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+    
+    size_t putUChar(const char* key, uint8_t value);
+    size_t putBool(const char* key, bool value);
+    size_t putInt(const char* key, int32_t value);
+    size_t putUInt(const char* key, uint32_t value);
+    size_t putULong(const char* key, uint32_t value);
+    size_t putString(const char* key, const char* value);
+    size_t putBytes(const char* key, const void* value, size_t length);
+    
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    bool getBool(const char* key, bool defaultValue = false);
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0);
+    size_t getString(const char* key, char* value, size_t maxLength);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+};
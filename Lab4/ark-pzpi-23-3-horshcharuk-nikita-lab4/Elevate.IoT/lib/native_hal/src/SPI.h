@@ -0,0 +1,13 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Шина на хості не потрібна: дисплей пише в пам'ять, зчитувача немає
+class SPIClass {
+public:
+    void begin() {}
+    void begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) {}
+    void end() {}
+};
+
+extern SPIClass SPI;
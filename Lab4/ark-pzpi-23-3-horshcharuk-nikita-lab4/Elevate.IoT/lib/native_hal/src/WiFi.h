@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================================
+// WiFi - Мережа хоста замість радіомодуля
+// ============================================================================
+// Хост уже в мережі, тож begin() лише відтворює події асоціації з тими
+// самими кодами, що й ESP32; сокети WiFiClient — звичайні TCP-сокети ОС
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_PS_NONE,
+    WIFI_PS_MIN_MODEM,
+    WIFI_PS_MAX_MODEM
+} wifi_ps_type_t;
+
+#define WIFI_OFF 0
+#define WIFI_STA 1
+
+typedef int WiFiEvent_t;
+typedef int wifi_event_id_t;
+
+#define ARDUINO_EVENT_WIFI_STA_CONNECTED 4
+#define ARDUINO_EVENT_WIFI_STA_DISCONNECTED 5
+#define ARDUINO_EVENT_WIFI_STA_GOT_IP 7
+#define ARDUINO_EVENT_WIFI_STA_LOST_IP 8
+
+typedef union {
+    struct {
+        uint8_t bssid[6];
+        uint8_t channel;
+        uint8_t reason;
+    } wifi_sta_disconnected;
+    struct {
+        uint8_t bssid[6];
+        uint8_t channel;
+    } wifi_sta_connected;
+} WiFiEventInfo_t;
+
+typedef void (*WiFiEventCb)(WiFiEvent_t event, WiFiEventInfo_t info);
+
+class WiFiClient : public Stream {
+private:
+    static const size_t RX_BUFFER_SIZE = 1460; // один TCP-сегмент, як pbuf у lwIP
+    
+    int fd;
+    uint8_t rxBuffer[RX_BUFFER_SIZE];
+    size_t rxStart;
+    size_t rxEnd;
+    
+    bool fill(int timeoutMs);
+    
+protected:
+    bool waitAvailable(unsigned long timeoutMs) override;
+    
+public:
+    WiFiClient() : fd(-1), rxStart(0), rxEnd(0) {}
+    ~WiFiClient() { stop(); }
+    
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+    
+    int connect(const char* host, uint16_t port);
+    int connect(IPAddress ip, uint16_t port);
+    uint8_t connected();
+    void stop();
+    
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    
+    int available() override;
+    int read() override;
+    int peek() override;
+    
+    void setNoDelay(bool noDelay);
+    operator bool() { return connected(); }
+};
+
+class WiFiClass {
+private:
+    wl_status_t currentStatus = WL_IDLE_STATUS;
+    IPAddress staticIp;
+    
+public:
+    bool mode(int mode) { return true; }
+    void persistent(bool persistent) {}
+    bool setAutoReconnect(bool autoReconnect) { return true; }
+    bool setSleep(bool enabled) { return true; }
+    bool setSleep(wifi_ps_type_t type) { return true; }
+    wifi_event_id_t onEvent(WiFiEventCb callback, WiFiEvent_t event = 0);
+    
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress localIp, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    wl_status_t status() { return currentStatus; }
+    
+    IPAddress localIP();
+    IPAddress gatewayIP() { return IPAddress(127, 0, 0, 1); }
+    IPAddress subnetMask() { return IPAddress(255, 0, 0, 0); }
+    IPAddress dnsIP(uint8_t index = 0) { return IPAddress(127, 0, 0, 53); }
+    uint8_t* BSSID();
+    int32_t channel() { return 1; }
+    int8_t RSSI() { return -40; }
+    
+    // Для сценаріїв: обрив лінку з кодом причини ESP32 (8 — ASSOC_LEAVE)
+    void simulateLoss(uint8_t reason = 8);
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,603 @@
+#include <Arduino.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <ctype.h>
+#include <malloc.h>
+#include <poll.h>
+#include <unistd.h>
+#include "native_hal.h"
+#include <driver/gpio.h>
+#include <driver/uart.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+
+// ============================================================================
+// Час
+// ============================================================================
+static std::chrono::steady_clock::time_point startTime() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+static uint64_t elapsedNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime()).count();
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)(elapsedNanos() / 1000);
+}
+
+unsigned long millis() {
+    return (unsigned long)(elapsedNanos() / 1000000);
+}
+
+unsigned long micros() {
+    return (unsigned long)(elapsedNanos() / 1000);
+}
+
+void delay(unsigned long ms) {
+    NativeHal::WaitScope wait;
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+// ============================================================================
+// GPIO та переривання
+// ============================================================================
+namespace {
+    const int PIN_COUNT = 40; // GPIO0..GPIO39, як у ESP32
+    
+    struct PinState {
+        int level = HIGH;
+        int mode = 0;
+        void (*handler)(void*) = nullptr;
+        void (*plainHandler)() = nullptr;
+        void* arg = nullptr;
+        bool interruptEnabled = true;
+        bool inHandler = false;
+        bool wakeEnabled = false;
+    };
+    
+    PinState pinStates[PIN_COUNT];
+    
+    // Обробники не вкладаються один в одного, як GPIO-ISR на одному ядрі
+    std::recursive_mutex interruptMutex;
+    
+    bool isValidPin(int pin) {
+        return pin >= 0 && pin < PIN_COUNT;
+    }
+    
+    void callHandler(PinState& state) {
+        if (state.handler != nullptr) {
+            state.handler(state.arg);
+        } else if (state.plainHandler != nullptr) {
+            state.plainHandler();
+        }
+    }
+    
+    bool isLevelPresent(const PinState& state) {
+        return (state.mode == ONLOW && state.level == LOW) || (state.mode == ONHIGH && state.level == HIGH);
+    }
+    
+    // Рівневе переривання повторюється, поки рівень тримається. Обробник
+    // зазвичай перемикає тип на протилежний рівень; виклик зсередини
+    // обробника лише відкладає повтор до його повернення
+    void serviceLevel(PinState& state) {
+        if (state.inHandler) return;
+        
+        while (state.interruptEnabled && isLevelPresent(state)) {
+            state.inHandler = true;
+            callHandler(state);
+            state.inHandler = false;
+        }
+    }
+    
+    void setInterruptMode(int pin, int mode) {
+        pinStates[pin].mode = mode & 0x07;
+        if (mode & 0x08) pinStates[pin].wakeEnabled = true;
+        serviceLevel(pinStates[pin]);
+    }
+}
+
+void pinMode(int pin, int mode) {
+    if (!isValidPin(pin)) return;
+    if (mode == INPUT_PULLUP) pinStates[pin].level = HIGH;
+}
+
+int digitalRead(int pin) {
+    return isValidPin(pin) ? pinStates[pin].level : LOW;
+}
+
+void digitalWrite(int pin, int value) {
+    if (isValidPin(pin)) pinStates[pin].level = value ? HIGH : LOW;
+}
+
+int digitalPinToInterrupt(int pin) {
+    return isValidPin(pin) ? pin : -1;
+}
+
+void attachInterrupt(int interrupt, void (*handler)(), int mode) {
+    if (!isValidPin(interrupt)) return;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    pinStates[interrupt].plainHandler = handler;
+    pinStates[interrupt].handler = nullptr;
+    setInterruptMode(interrupt, mode);
+}
+
+void attachInterruptArg(int interrupt, void (*handler)(void*), void* arg, int mode) {
+    if (!isValidPin(interrupt)) return;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    pinStates[interrupt].handler = handler;
+    pinStates[interrupt].plainHandler = nullptr;
+    pinStates[interrupt].arg = arg;
+    setInterruptMode(interrupt, mode);
+}
+
+void detachInterrupt(int interrupt) {
+    if (!isValidPin(interrupt)) return;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    pinStates[interrupt].handler = nullptr;
+    pinStates[interrupt].plainHandler = nullptr;
+}
+
+void NativeHal::setPinLevel(int pin, int level) {
+    if (!isValidPin(pin)) return;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    PinState& state = pinStates[pin];
+    level = level ? HIGH : LOW;
+    if (state.level == level) return;
+    state.level = level;
+    
+    if (!state.interruptEnabled) return;
+    if (state.mode == ONLOW || state.mode == ONHIGH) {
+        serviceLevel(state);
+        return;
+    }
+    
+    bool rising = level == HIGH;
+    bool fires = state.mode == CHANGE || (rising && state.mode == RISING) ||
+                 (!rising && state.mode == FALLING);
+    if (fires) callHandler(state);
+}
+
+// ============================================================================
+// GPIO ESP-IDF та джерела пробудження
+// ============================================================================
+esp_err_t gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type) {
+    if (!isValidPin(pin)) return ESP_FAIL;
+    
+    static const int MODES[] = { 0, RISING, FALLING, CHANGE, ONLOW, ONHIGH };
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    setInterruptMode(pin, MODES[type]);
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t pin) {
+    if (!isValidPin(pin)) return ESP_FAIL;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    pinStates[pin].interruptEnabled = true;
+    serviceLevel(pinStates[pin]);
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t pin) {
+    if (!isValidPin(pin)) return ESP_FAIL;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    pinStates[pin].interruptEnabled = false;
+    return ESP_OK;
+}
+
+// Як і на ESP32, тип пробудження — це й тип переривання лінії
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t type) {
+    if (!isValidPin(pin) || (type != GPIO_INTR_LOW_LEVEL && type != GPIO_INTR_HIGH_LEVEL)) return ESP_FAIL;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    setInterruptMode(pin, (type == GPIO_INTR_LOW_LEVEL ? ONLOW : ONHIGH) | 0x08);
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t pin) {
+    if (!isValidPin(pin)) return ESP_FAIL;
+    
+    std::lock_guard<std::recursive_mutex> lock(interruptMutex);
+    pinStates[pin].wakeEnabled = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup() {
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_uart_wakeup(int uartNum) {
+    return uartNum == UART_NUM_0 ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t uartNum, int wakeupThreshold) {
+    return uartNum == UART_NUM_0 && wakeupThreshold >= 3 ? ESP_OK : ESP_FAIL;
+}
+
+// ============================================================================
+// Керування живленням
+// ============================================================================
+struct esp_pm_lock {
+    esp_pm_lock_type_t type;
+    int count;
+};
+
+namespace {
+    std::mutex pmMutex;
+    esp_pm_config_esp32_t pmConfig = {};
+}
+
+esp_err_t esp_pm_configure(const void* config) {
+    const esp_pm_config_esp32_t* requested = (const esp_pm_config_esp32_t*)config;
+    if (requested->min_freq_mhz > requested->max_freq_mhz) return ESP_FAIL;
+    
+    std::lock_guard<std::mutex> lock(pmMutex);
+    pmConfig = *requested;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name, esp_pm_lock_handle_t* handle) {
+    *handle = new esp_pm_lock { type, 0 };
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle) {
+    std::lock_guard<std::mutex> lock(pmMutex);
+    handle->count++;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle) {
+    std::lock_guard<std::mutex> lock(pmMutex);
+    if (handle->count == 0) return ESP_ERR_INVALID_STATE;
+    handle->count--;
+    return ESP_OK;
+}
+
+// ============================================================================
+// Випадкові числа
+// ============================================================================
+static std::mt19937& randomEngine() {
+    static std::mt19937 engine(1);
+    return engine;
+}
+
+namespace NativeHal {
+    void seedRandom(uint32_t seed) {
+        randomEngine().seed(seed);
+    }
+}
+
+uint32_t esp_random() {
+    return randomEngine()();
+}
+
+long random(long maxValue) {
+    return maxValue > 0 ? (long)(esp_random() % (uint32_t)maxValue) : 0;
+}
+
+long random(long minValue, long maxValue) {
+    return maxValue > minValue ? minValue + random(maxValue - minValue) : minValue;
+}
+
+// ============================================================================
+// Print та Stream
+// ============================================================================
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written])) written++;
+    return written;
+}
+
+size_t Print::print(long value, int base) {
+    if (base == DEC) {
+        char text[24];
+        snprintf(text, sizeof(text), "%ld", value);
+        return write(text);
+    }
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char text[24];
+    snprintf(text, sizeof(text), base == HEX ? "%lX" : "%lu", value);
+    return write(text);
+}
+
+size_t Print::printf(const char* format, ...) {
+    char stackBuffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+    if (length < 0) return 0;
+    if ((size_t)length < sizeof(stackBuffer)) return write((const uint8_t*)stackBuffer, length);
+    
+    std::string heapBuffer(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&heapBuffer[0], heapBuffer.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)heapBuffer.data(), length);
+}
+
+bool Stream::waitAvailable(unsigned long timeoutMs) {
+    unsigned long start = millis();
+    while (available() <= 0) {
+        if (millis() - start >= timeoutMs) return false;
+        delay(1);
+    }
+    return true;
+}
+
+int Stream::timedRead() {
+    int c = read();
+    if (c >= 0 || !waitAvailable(_timeout)) return c;
+    return read();
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+// ============================================================================
+// String
+// ============================================================================
+static std::string formatNumber(unsigned long value, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) base = DEC;
+    
+    std::string digits;
+    do {
+        int digit = value % base;
+        digits.insert(digits.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+        value /= base;
+    } while (value > 0);
+    if (negative) digits.insert(digits.begin(), '-');
+    return digits;
+}
+
+String::String(int number, unsigned char base)
+    : value(formatNumber(number < 0 && base == DEC ? -(long)number : (unsigned int)number,
+                         number < 0 && base == DEC, base)) {}
+
+String::String(unsigned int number, unsigned char base) : value(formatNumber(number, false, base)) {}
+
+String::String(long number, unsigned char base)
+    : value(formatNumber(number < 0 && base == DEC ? -(unsigned long)number : (unsigned long)number,
+                         number < 0 && base == DEC, base)) {}
+
+String::String(unsigned long number, unsigned char base) : value(formatNumber(number, false, base)) {}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t position = value.find(c, from);
+    return position == std::string::npos ? -1 : (int)position;
+}
+
+int String::indexOf(const char* text, unsigned int from) const {
+    size_t position = value.find(text != nullptr ? text : "", from);
+    return position == std::string::npos ? -1 : (int)position;
+}
+
+String String::substring(unsigned int from) const {
+    return from < value.size() ? String(value.substr(from)) : String();
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    return from < value.size() ? String(value.substr(from, to - from)) : String();
+}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (value.size() != other.value.size()) return false;
+    for (size_t i = 0; i < value.size(); i++) {
+        if (tolower((unsigned char)value[i]) != tolower((unsigned char)other.value[i])) return false;
+    }
+    return true;
+}
+
+void String::trim() {
+    size_t begin = value.find_first_not_of(" \t\r\n");
+    size_t end = value.find_last_not_of(" \t\r\n");
+    value = begin == std::string::npos ? std::string() : value.substr(begin, end - begin + 1);
+}
+
+void String::toLowerCase() {
+    for (size_t i = 0; i < value.size(); i++) {
+        value[i] = (char)tolower((unsigned char)value[i]);
+    }
+}
+
+// ============================================================================
+// Serial
+// ============================================================================
+HardwareSerial Serial;
+
+namespace {
+    // Прийом після onReceive(): і stdin, і рядки сценарію йдуть через буфер
+    std::mutex serialMutex;
+    std::string serialInput;
+    HardwareSerial::OnReceiveCb receiveCallback = nullptr;
+    
+    void deliverSerial(const char* data, size_t length) {
+        HardwareSerial::OnReceiveCb callback;
+        {
+            std::lock_guard<std::mutex> lock(serialMutex);
+            serialInput.append(data, length);
+            callback = receiveCallback;
+        }
+        if (callback != nullptr) callback();
+    }
+    
+    void readStdin() {
+        while (!NativeHal::isFinished()) {
+            struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+            if (poll(&input, 1, 100) <= 0) continue;
+            
+            char chunk[64];
+            ssize_t length = ::read(STDIN_FILENO, chunk, sizeof(chunk));
+            if (length <= 0) return; // stdin закрито
+            deliverSerial(chunk, (size_t)length);
+        }
+    }
+}
+
+void NativeHal::feedSerial(const char* text) {
+    std::string line(text);
+    line += '\n';
+    deliverSerial(line.data(), line.size());
+}
+
+void HardwareSerial::onReceive(OnReceiveCb callback, bool onlyOnTimeout) {
+    bool first;
+    {
+        std::lock_guard<std::mutex> lock(serialMutex);
+        first = receiveCallback == nullptr;
+        receiveCallback = callback;
+    }
+    if (first) std::thread(readStdin).detach();
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+int HardwareSerial::available() {
+    if (peeked >= 0) return 1;
+    
+    {
+        std::lock_guard<std::mutex> lock(serialMutex);
+        if (receiveCallback != nullptr) return (int)serialInput.size();
+    }
+    
+    struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    return poll(&input, 1, 0) > 0 && (input.revents & POLLIN) ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+    if (peeked >= 0) {
+        int c = peeked;
+        peeked = -1;
+        return c;
+    }
+    if (!available()) return -1;
+    
+    {
+        std::lock_guard<std::mutex> lock(serialMutex);
+        if (receiveCallback != nullptr) {
+            uint8_t c = (uint8_t)serialInput[0];
+            serialInput.erase(0, 1);
+            return c;
+        }
+    }
+    
+    uint8_t c;
+    return ::read(STDIN_FILENO, &c, 1) == 1 ? c : -1;
+}
+
+int HardwareSerial::peek() {
+    if (peeked < 0) peeked = read();
+    return peeked;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+// ============================================================================
+// IPAddress
+// ============================================================================
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(text);
+}
+
+bool IPAddress::fromString(const char* text) {
+    unsigned int a, b, c, d;
+    if (text == nullptr || sscanf(text, "%u.%u.%u.%u", &a, &b, &c, &d) != 4) return false;
+    if (a > 255 || b > 255 || c > 255 || d > 255) return false;
+    *this = IPAddress(a, b, c, d);
+    return true;
+}
+
+// ============================================================================
+// ESP
+// ============================================================================
+EspClass ESP;
+
+namespace {
+    const uint32_t HEAP_SIZE = 320 * 1024; // DRAM, доступна Arduino-ESP32 після старту
+    uint32_t baselineHeapUse = 0;
+    std::atomic<uint32_t> minFreeHeap(HEAP_SIZE); // оновлюють і задачі, і потік вибірки
+    
+    uint32_t heapInUse() {
+        struct mallinfo2 info = mallinfo2();
+        return (uint32_t)info.uordblks;
+    }
+}
+
+namespace NativeHal {
+    // Виділене до setup() (бібліотеки хоста) не рахується в купу ESP32
+    void markHeapBaseline() {
+        baselineHeapUse = heapInUse();
+    }
+}
+
+uint32_t EspClass::getCycleCount() {
+    return (uint32_t)(elapsedNanos() * getCpuFreqMHz() / 1000);
+}
+
+uint32_t EspClass::getHeapSize() {
+    return HEAP_SIZE;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    uint32_t used = heapInUse();
+    used = used > baselineHeapUse ? used - baselineHeapUse : 0;
+    uint32_t freeHeap = used < HEAP_SIZE ? HEAP_SIZE - used : 0;
+    uint32_t lowest = minFreeHeap.load();
+    while (freeHeap < lowest && !minFreeHeap.compare_exchange_weak(lowest, freeHeap)) {}
+    return freeHeap;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    getFreeHeap();
+    return minFreeHeap;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return getFreeHeap();
+}
+
+void EspClass::restart() {
+    fflush(stdout);
+    _exit(0);
+}
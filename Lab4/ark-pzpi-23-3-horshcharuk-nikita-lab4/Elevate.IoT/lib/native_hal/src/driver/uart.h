@@ -0,0 +1,14 @@
+#pragma once
+
+#include "esp_err.h"
+
+// ============================================================================
+// UART - Поріг пробудження з light sleep
+// ============================================================================
+typedef enum {
+    UART_NUM_0,
+    UART_NUM_1,
+    UART_NUM_2
+} uart_port_t;
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t uartNum, int wakeupThreshold);
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+
+// ============================================================================
+// Хуки FreeRTOS ESP-IDF
+// ============================================================================
+// Тік-хук викликається окремим потоком раз на тік для всіх ядер одразу
+typedef void (*esp_freertos_tick_cb_t)();
+
+esp_err_t esp_register_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t callback, UBaseType_t cpuId);
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// ============================================================================
+// Джерела пробудження з light sleep
+// ============================================================================
+// На хості чип не засинає, тож джерела лише перевіряються й запам'ятовуються
+esp_err_t esp_sleep_enable_gpio_wakeup();
+esp_err_t esp_sleep_enable_uart_wakeup(int uartNum);
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Мікросекунди від запуску процесу
+int64_t esp_timer_get_time();
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// ============================================================================
+// esp_wifi - Конфігурація станції поза WiFiClass
+// ============================================================================
+// Лише те, що WiFiClass не задає сам: інтервал прослуховування маяків
+typedef enum {
+    WIFI_IF_STA,
+    WIFI_IF_AP
+} wifi_interface_t;
+
+typedef struct {
+    uint8_t ssid[32];
+    uint8_t password[64];
+    uint16_t listen_interval;
+} wifi_sta_config_t;
+
+typedef union {
+    wifi_sta_config_t sta;
+} wifi_config_t;
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* config);
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* config);
+esp_err_t esp_wifi_connect();
@@ -0,0 +1,256 @@
+#include <Arduino.h>
+#include <esp_freertos_hooks.h>
+#include "native_hal.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Задачі
+// ============================================================================
+namespace {
+    struct NativeTask {
+        std::mutex mutex;
+        std::condition_variable wake;
+        uint32_t notifications = 0;
+        BaseType_t coreId = 1;
+        std::atomic<int> waits{0};
+    };
+    
+    // Усі задачі, щоб тік-хук міг знайти ту, що зараз працює на ядрі
+    std::mutex registryMutex;
+    std::vector<NativeTask*> registry;
+    NativeTask idleTasks[2];
+    
+    NativeTask* registerTask(NativeTask* task) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.push_back(task);
+        return task;
+    }
+    
+    // Короткі потоки (події Wi-Fi) зникають з реєстру разом із собою
+    struct ThreadTask {
+        NativeTask* task = nullptr;
+        
+        ~ThreadTask() {
+            if (task == nullptr) return;
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry.erase(std::find(registry.begin(), registry.end(), task));
+        }
+    };
+    
+    // Головний потік — це loopTask Arduino, що працює на ядрі 1
+    thread_local ThreadTask currentTask;
+    
+    NativeTask* getCurrentTask() {
+        if (currentTask.task == nullptr) currentTask.task = registerTask(new NativeTask());
+        return currentTask.task;
+    }
+    
+    // Чекає на умову не довше ticks; portMAX_DELAY — без обмеження
+    template <typename Predicate>
+    bool waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock,
+                 TickType_t ticks, Predicate predicate) {
+        if (ticks == portMAX_DELAY) {
+            condition.wait(lock, predicate);
+            return true;
+        }
+        return condition.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), predicate);
+    }
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t coreId) {
+    NativeTask* task = new NativeTask();
+    task->coreId = coreId;
+    registerTask(task);
+    if (handle != nullptr) *handle = task;
+    
+    std::thread([task, function, parameter]() {
+        currentTask.task = task;
+        function(parameter);
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return getCurrentTask();
+}
+
+BaseType_t xPortGetCoreID() {
+    return getCurrentTask()->coreId;
+}
+
+// Задачею ядра вважається перша, що зараз не чекає; якщо чекають усі,
+// ядро віддане idle
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t cpuId) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = 0; i < registry.size(); i++) {
+        if (registry[i]->coreId == cpuId && registry[i]->waits.load() == 0) return registry[i];
+    }
+    return xTaskGetIdleTaskHandleForCPU(cpuId);
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t cpuId) {
+    return &idleTasks[cpuId % 2];
+}
+
+void vTaskDelay(TickType_t ticks) {
+    NativeHal::WaitScope wait;
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(millis() / portTICK_PERIOD_MS);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+    NativeTask* task = getCurrentTask();
+    NativeHal::WaitScope wait;
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitFor(task->wake, lock, ticksToWait, [task]() { return task->notifications > 0; });
+    
+    uint32_t value = task->notifications;
+    if (value > 0) task->notifications = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle) {
+    NativeTask* task = (NativeTask*)handle;
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifications++;
+    }
+    task->wake.notify_one();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* higherPriorityTaskWoken) {
+    xTaskNotifyGive(handle);
+    if (higherPriorityTaskWoken != nullptr) *higherPriorityTaskWoken = pdTRUE;
+}
+
+// ============================================================================
+// Черги
+// ============================================================================
+namespace {
+    struct NativeQueue {
+        std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+        std::vector<uint8_t> storage;
+        UBaseType_t length;
+        UBaseType_t itemSize;
+        UBaseType_t head = 0;
+        UBaseType_t count = 0;
+        
+        NativeQueue(UBaseType_t length, UBaseType_t itemSize)
+            : storage(length * itemSize), length(length), itemSize(itemSize) {}
+    };
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    return length > 0 && itemSize > 0 ? new NativeQueue(length, itemSize) : nullptr;
+}
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void* item, TickType_t ticksToWait) {
+    NativeQueue* queue = (NativeQueue*)handle;
+    NativeHal::WaitScope wait;
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->notFull, lock, ticksToWait, [queue]() { return queue->count < queue->length; })) {
+        return pdFAIL;
+    }
+    
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(&queue->storage[tail * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+    lock.unlock();
+    queue->notEmpty.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t handle, const void* item, BaseType_t* higherPriorityTaskWoken) {
+    BaseType_t sent = xQueueSend(handle, item, 0);
+    if (higherPriorityTaskWoken != nullptr) *higherPriorityTaskWoken = sent;
+    return sent;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t ticksToWait) {
+    NativeQueue* queue = (NativeQueue*)handle;
+    NativeHal::WaitScope wait;
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->notEmpty, lock, ticksToWait, [queue]() { return queue->count > 0; })) {
+        return pdFAIL;
+    }
+    
+    memcpy(item, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    lock.unlock();
+    queue->notFull.notify_one();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t handle) {
+    NativeQueue* queue = (NativeQueue*)handle;
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t handle) {
+    NativeQueue* queue = (NativeQueue*)handle;
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->length - queue->count;
+}
+
+// ============================================================================
+// Критичні секції
+// ============================================================================
+static std::recursive_mutex criticalMutex;
+
+void portENTER_CRITICAL(portMUX_TYPE* mux) {
+    criticalMutex.lock();
+}
+
+void portEXIT_CRITICAL(portMUX_TYPE* mux) {
+    criticalMutex.unlock();
+}
+
+// ============================================================================
+// Тік-хуки
+// ============================================================================
+// Окремий потік раз на тік викликає хуки, як переривання таймера FreeRTOS
+namespace {
+    std::mutex hookMutex;
+    std::vector<esp_freertos_tick_cb_t> tickHooks;
+    
+    void runTicks() {
+        while (!NativeHal::isFinished()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(portTICK_PERIOD_MS));
+            std::lock_guard<std::mutex> lock(hookMutex);
+            for (size_t i = 0; i < tickHooks.size(); i++) tickHooks[i]();
+        }
+    }
+}
+
+esp_err_t esp_register_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t callback, UBaseType_t cpuId) {
+    std::lock_guard<std::mutex> lock(hookMutex);
+    if (tickHooks.empty()) std::thread(runTicks).detach();
+    tickHooks.push_back(callback);
+    return ESP_OK;
+}
+
+// ============================================================================
+// NativeHal::WaitScope
+// ============================================================================
+NativeHal::WaitScope::WaitScope() {
+    getCurrentTask()->waits++;
+}
+
+NativeHal::WaitScope::~WaitScope() {
+    getCurrentTask()->waits--;
+}
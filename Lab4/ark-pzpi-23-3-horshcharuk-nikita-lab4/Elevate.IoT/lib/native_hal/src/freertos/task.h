@@ -0,0 +1,26 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// ============================================================================
+// Задачі - Потоки ОС із лічильником сповіщень FreeRTOS
+// ============================================================================
+// Прив'язка до ядра лише запам'ятовується: xPortGetCoreID() повертає
+// ядро, на яке задачу поставила прошивка
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t coreId);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t cpuId);
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t cpuId);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
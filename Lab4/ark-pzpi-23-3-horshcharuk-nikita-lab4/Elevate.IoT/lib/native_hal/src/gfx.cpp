@@ -0,0 +1,340 @@
+#include <Adafruit_ILI9341.h>
+#include "native_hal.h"
+
+// ============================================================================
+// Шрифт
+// ============================================================================
+// Класичний шрифт 5x7 (ASCII 0x20..0x7E), по байту на стовпчик, молодший
+// біт зверху. Решта кодів малюється рамкою з бітами коду всередині, щоб
+// кожен із 256 символів мав власне зображення, як у glcdfont
+static const uint8_t FONT[][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 },
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 }, { 0x00, 0x1C, 0x22, 0x41, 0x00 },
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+    { 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x00, 0x60, 0x60, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x00, 0x14, 0x00, 0x00 },
+    { 0x00, 0x40, 0x34, 0x00, 0x00 }, { 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 }, { 0x3E, 0x41, 0x5D, 0x59, 0x4E },
+    { 0x7C, 0x12, 0x11, 0x12, 0x7C }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+    { 0x3E, 0x41, 0x41, 0x51, 0x73 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+    { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 },
+    { 0x26, 0x49, 0x49, 0x49, 0x32 }, { 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, { 0x63, 0x14, 0x08, 0x14, 0x63 },
+    { 0x03, 0x04, 0x78, 0x04, 0x03 }, { 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F }, { 0x04, 0x02, 0x01, 0x02, 0x04 },
+    { 0x40, 0x40, 0x40, 0x40, 0x40 }, { 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 },
+    { 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 }, { 0x38, 0x44, 0x44, 0x28, 0x7F },
+    { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x40, 0x3D, 0x00 },
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 }, { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 },
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, { 0xFC, 0x18, 0x24, 0x24, 0x18 },
+    { 0x18, 0x24, 0x24, 0x18, 0xFC }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 },
+    { 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C },
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C }, { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C },
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, { 0x00, 0x00, 0x77, 0x00, 0x00 },
+    { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x02, 0x01, 0x02, 0x04, 0x02 },
+};
+
+static_assert(sizeof(FONT) / sizeof(FONT[0]) == 0x7E - 0x20 + 1, "FONT must cover ASCII 0x20..0x7E");
+
+static const uint8_t* getGlyph(unsigned char c) {
+    if (c >= 0x20 && c <= 0x7E) return FONT[c - 0x20];
+    
+    static uint8_t box[5];
+    box[0] = box[4] = 0x7F;
+    box[1] = 0x41 | ((c & 0x1F) << 1);
+    box[2] = 0x41 | ((c >> 5) << 1);
+    box[3] = 0x41;
+    return box;
+}
+
+// ============================================================================
+// Adafruit_GFX
+// ============================================================================
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    fillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    for (int16_t row = y; row < y + h; row++) {
+        for (int16_t column = x; column < x + w; column++) writePixel(column, row, color);
+    }
+    endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastVLine(x, y, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                              uint16_t color) {
+    int16_t rowBytes = (w + 7) / 8;
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * rowBytes + i / 8] & (0x80 >> (i & 7))) writePixel(x + i, y + j, color);
+        }
+    }
+    endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                              uint16_t color, uint16_t bg) {
+    int16_t rowBytes = (w + 7) / 8;
+    startWrite();
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            bool set = bitmap[j * rowBytes + i / 8] & (0x80 >> (i & 7));
+            writePixel(x + i, y + j, set ? color : bg);
+        }
+    }
+    endWrite();
+}
+
+// Той самий обхід, що в Adafruit_GFX::drawChar для класичного шрифту
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                            uint8_t size) {
+    if (x >= _width || y >= _height || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0) return;
+    
+    const uint8_t* glyph = getGlyph(c);
+    startWrite();
+    for (int8_t i = 0; i < 5; i++) {
+        uint8_t line = glyph[i];
+        for (int8_t j = 0; j < 8; j++, line >>= 1) {
+            if (line & 1) {
+                if (size == 1) {
+                    writePixel(x + i, y + j, color);
+                } else {
+                    writeFillRect(x + i * size, y + j * size, size, size, color);
+                }
+            } else if (bg != color) {
+                if (size == 1) {
+                    writePixel(x + i, y + j, bg);
+                } else {
+                    writeFillRect(x + i * size, y + j * size, size, size, bg);
+                }
+            }
+        }
+    }
+    if (bg != color) {
+        if (size == 1) {
+            writeFastVLine(x + 5, y, 8, bg);
+        } else {
+            writeFillRect(x + 5 * size, y, size, 8 * size, bg);
+        }
+    }
+    endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+    } else if (c != '\r') {
+        if (wrap && cursor_x + textsize_x * 6 > _width) {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x);
+        cursor_x += textsize_x * 6;
+    }
+    return 1;
+}
+
+void Adafruit_GFX::setRotation(uint8_t rotation) {
+    this->rotation = rotation & 3;
+    bool landscape = this->rotation & 1;
+    _width = landscape ? HEIGHT : WIDTH;
+    _height = landscape ? WIDTH : HEIGHT;
+}
+
+// ============================================================================
+// Полотна
+// ============================================================================
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    buffer = (uint8_t*)calloc((w + 7) / 8 * h, 1);
+}
+
+GFXcanvas1::~GFXcanvas1() {
+    free(buffer);
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (buffer == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    
+    uint8_t* byte = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+    if (color) {
+        *byte |= 0x80 >> (x & 7);
+    } else {
+        *byte &= ~(0x80 >> (x & 7));
+    }
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+    if (buffer != nullptr) memset(buffer, color ? 0xFF : 0x00, (WIDTH + 7) / 8 * HEIGHT);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+    if (buffer == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
+
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    buffer = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+}
+
+GFXcanvas16::~GFXcanvas16() {
+    free(buffer);
+}
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (buffer == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    buffer[x + y * WIDTH] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color) {
+    if (buffer == nullptr) return;
+    for (uint32_t i = 0; i < (uint32_t)WIDTH * HEIGHT; i++) buffer[i] = color;
+}
+
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
+    if (buffer == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    return buffer[x + y * WIDTH];
+}
+
+// ============================================================================
+// Adafruit_SPITFT
+// ============================================================================
+// Буфер індексується в координатах після повороту: прошивка задає
+// поворот один раз під час запуску
+Adafruit_SPITFT::Adafruit_SPITFT(int16_t w, int16_t h) : Adafruit_GFX(w, h) {
+    framebuffer = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+}
+
+Adafruit_SPITFT::~Adafruit_SPITFT() {
+    free(framebuffer);
+}
+
+void Adafruit_SPITFT::storePixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    framebuffer[x + y * _width] = color;
+}
+
+void Adafruit_SPITFT::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    windowX = x;
+    windowY = y;
+    windowWidth = w;
+    windowHeight = h;
+    windowOffset = 0;
+    windows++;
+}
+
+void Adafruit_SPITFT::writePixels(uint16_t* colors, uint32_t length, bool block, bool bigEndian) {
+    if (windowWidth <= 0) return;
+    
+    for (uint32_t i = 0; i < length; i++, windowOffset++) {
+        storePixel(windowX + windowOffset % windowWidth, windowY + windowOffset / windowWidth, colors[i]);
+    }
+    pixels += length;
+}
+
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t length) {
+    if (windowWidth <= 0) return;
+    
+    for (uint32_t i = 0; i < length; i++, windowOffset++) {
+        storePixel(windowX + windowOffset % windowWidth, windowY + windowOffset / windowWidth, color);
+    }
+    pixels += length;
+}
+
+// Піксель за пікселем драйвер відкриває вікно 1x1 на кожну точку
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    setAddrWindow(x, y, 1, 1);
+    writeColor(color, 1);
+}
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    startWrite();
+    writePixel(x, y, color);
+    endWrite();
+}
+
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    
+    int16_t x2 = min((int16_t)(x + w), _width);
+    int16_t y2 = min((int16_t)(y + h), _height);
+    x = max(x, (int16_t)0);
+    y = max(y, (int16_t)0);
+    if (x >= x2 || y >= y2) return;
+    
+    setAddrWindow(x, y, x2 - x, y2 - y);
+    writeColor(color, (uint32_t)(x2 - x) * (y2 - y));
+}
+
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFillRect(x, y, w, h, color);
+    endWrite();
+}
+
+uint16_t Adafruit_SPITFT::getPixel(int16_t x, int16_t y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    return framebuffer[x + y * _width];
+}
+
+bool Adafruit_SPITFT::savePpm(const char* path) const {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) return false;
+    
+    fprintf(file, "P6\n%d %d\n255\n", _width, _height);
+    for (int32_t i = 0; i < (int32_t)_width * _height; i++) {
+        uint16_t color = framebuffer[i];
+        uint8_t rgb[3] = {
+            (uint8_t)(((color >> 11) & 0x1F) * 255 / 31),
+            (uint8_t)(((color >> 5) & 0x3F) * 255 / 63),
+            (uint8_t)((color & 0x1F) * 255 / 31)
+        };
+        fwrite(rgb, 1, sizeof(rgb), file);
+    }
+    return fclose(file) == 0;
+}
+
+// Дисплей, який підняла прошивка, зберігається в PPM після прогону
+static const Adafruit_SPITFT* activePanel = nullptr;
+
+void Adafruit_ILI9341::begin(uint32_t freq) {
+    setRotation(0);
+    activePanel = this;
+}
+
+bool NativeHal::saveFramebuffer(const char* path) {
+    return activePanel != nullptr && activePanel->savePpm(path);
+}
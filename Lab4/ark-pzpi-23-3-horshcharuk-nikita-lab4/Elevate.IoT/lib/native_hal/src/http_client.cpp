@@ -0,0 +1,205 @@
+#include <HTTPClient.h>
+
+// ============================================================================
+// Адреса та з'єднання
+// ============================================================================
+bool HTTPClient::parseUrl(const String& url) {
+    const char* text = url.c_str();
+    if (strncmp(text, "http://", 7) != 0) return false;
+    text += 7;
+    
+    size_t hostLength = strcspn(text, ":/");
+    host = String(std::string(text, hostLength));
+    text += hostLength;
+    
+    port = 80;
+    if (*text == ':') {
+        port = (uint16_t)atoi(text + 1);
+        text += strcspn(text, "/");
+    }
+    uri = *text != '\0' ? String(text) : String("/");
+    return host.length() > 0;
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+    if (this->client != nullptr && this->client != &client) end();
+    
+    this->client = &client;
+    requestHeaders = "";
+    size = -1;
+    for (size_t i = 0; i < collected.size(); i++) collected[i].value = "";
+    return parseUrl(url);
+}
+
+bool HTTPClient::begin(const String& url) {
+    return begin(ownClient, url);
+}
+
+// Непрочитаний залишок відповіді викидається, а сокет лишається
+// відкритим лише коли сервер дозволив keep-alive
+void HTTPClient::end() {
+    if (client == nullptr) return;
+    
+    if (client->connected()) {
+        while (client->available() > 0) client->read();
+        if (!reuse || !canReuse) client->stop();
+    }
+    canReuse = false;
+}
+
+bool HTTPClient::connected() {
+    return client != nullptr && client->connected();
+}
+
+bool HTTPClient::connect() {
+    if (client == nullptr) return false;
+    if (client->connected()) {
+        while (client->available() > 0) client->read();
+        return true;
+    }
+    return client->connect(host.c_str(), port) == 1;
+}
+
+// ============================================================================
+// Заголовки
+// ============================================================================
+void HTTPClient::addHeader(const String& name, const String& value, bool first, bool replace) {
+    String line = name + ": " + value + "\r\n";
+    if (first) {
+        requestHeaders = line + requestHeaders;
+    } else {
+        requestHeaders += line;
+    }
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    collected.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        Header header;
+        header.key = headerKeys[i];
+        collected.push_back(header);
+    }
+}
+
+String HTTPClient::header(const char* name) {
+    for (size_t i = 0; i < collected.size(); i++) {
+        if (collected[i].key.equalsIgnoreCase(name)) return collected[i].value;
+    }
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+    return header(name).length() > 0;
+}
+
+// ============================================================================
+// Запит і відповідь
+// ============================================================================
+int HTTPClient::GET() {
+    return sendRequest("GET");
+}
+
+int HTTPClient::POST(uint8_t* payload, size_t size) {
+    return sendRequest("POST", payload, size);
+}
+
+int HTTPClient::sendRequest(const char* type, uint8_t* payload, size_t size) {
+    if (!connect()) return HTTPC_ERROR_CONNECTION_REFUSED;
+    
+    String request = String(type) + " " + uri + " HTTP/1.1\r\n" +
+                     "Host: " + host + "\r\n" +
+                     "User-Agent: ESP32HTTPClient\r\n" +
+                     "Connection: " + (reuse ? "keep-alive" : "close") + "\r\n";
+    if (payload != nullptr || strcmp(type, "POST") == 0) {
+        request += "Content-Length: " + String((unsigned long)size) + "\r\n";
+    }
+    request += requestHeaders;
+    request += "\r\n";
+    
+    client->setTimeout(timeoutMs);
+    if (client->write((const uint8_t*)request.c_str(), request.length()) != request.length()) {
+        return HTTPC_ERROR_SEND_HEADER_FAILED;
+    }
+    if (payload != nullptr && size > 0 && client->write(payload, size) != size) {
+        return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    }
+    return handleHeaderResponse();
+}
+
+bool HTTPClient::readLine(String& line) {
+    line = "";
+    while (true) {
+        char c;
+        if (client->readBytes(&c, 1) != 1) return false;
+        if (c == '\n') return true;
+        if (c != '\r') line += c;
+    }
+}
+
+int HTTPClient::handleHeaderResponse() {
+    if (!client->connected()) return HTTPC_ERROR_NOT_CONNECTED;
+    
+    String line;
+    unsigned long start = millis();
+    if (!readLine(line)) {
+        return millis() - start >= timeoutMs ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST;
+    }
+    if (!line.startsWith("HTTP/1.")) return HTTPC_ERROR_NO_HTTP_SERVER;
+    
+    int code = line.substring(9, 12).toInt();
+    size = -1;
+    canReuse = line.startsWith("HTTP/1.1");
+    
+    while (readLine(line)) {
+        if (line.length() == 0) {
+            // Без тіла: сокет уже готовий до наступного запиту
+            if (code == HTTP_CODE_NO_CONTENT || code == HTTP_CODE_NOT_MODIFIED) size = 0;
+            return code;
+        }
+        
+        int colon = line.indexOf(':');
+        if (colon <= 0) continue;
+        String key = line.substring(0, colon);
+        String value = line.substring(colon + 1);
+        value.trim();
+        
+        if (key.equalsIgnoreCase("Content-Length")) {
+            size = (int)value.toInt();
+        } else if (key.equalsIgnoreCase("Connection") && value.equalsIgnoreCase("close")) {
+            canReuse = false;
+        }
+        for (size_t i = 0; i < collected.size(); i++) {
+            if (collected[i].key.equalsIgnoreCase(key.c_str())) collected[i].value = value;
+        }
+    }
+    return HTTPC_ERROR_CONNECTION_LOST;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_REFUSED:
+            return String("connection refused");
+        case HTTPC_ERROR_SEND_HEADER_FAILED:
+            return String("send header failed");
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED:
+            return String("send payload failed");
+        case HTTPC_ERROR_NOT_CONNECTED:
+            return String("not connected");
+        case HTTPC_ERROR_CONNECTION_LOST:
+            return String("connection lost");
+        case HTTPC_ERROR_NO_STREAM:
+            return String("no stream");
+        case HTTPC_ERROR_NO_HTTP_SERVER:
+            return String("no HTTP server");
+        case HTTPC_ERROR_TOO_LESS_RAM:
+            return String("too less ram");
+        case HTTPC_ERROR_ENCODING:
+            return String("Transfer-Encoding not supported");
+        case HTTPC_ERROR_STREAM_WRITE:
+            return String("Stream write error");
+        case HTTPC_ERROR_READ_TIMEOUT:
+            return String("read Timeout");
+        default:
+            return String();
+    }
+}
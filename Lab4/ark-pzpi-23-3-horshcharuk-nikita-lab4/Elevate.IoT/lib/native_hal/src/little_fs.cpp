@@ -0,0 +1,97 @@
+#include <LittleFS.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "native_hal.h"
+
+fs::LittleFSFS LittleFS;
+
+// ============================================================================
+// File
+// ============================================================================
+fs::File::File(FILE* file) : handle(file, fclose) {}
+
+size_t fs::File::write(const uint8_t* buffer, size_t size) {
+    return handle ? fwrite(buffer, 1, size, handle.get()) : 0;
+}
+
+int fs::File::available() {
+    if (!handle) return 0;
+    size_t total = size();
+    size_t current = position();
+    return current < total ? (int)(total - current) : 0;
+}
+
+int fs::File::read() {
+    return handle ? fgetc(handle.get()) : -1;
+}
+
+int fs::File::peek() {
+    if (!handle) return -1;
+    int c = fgetc(handle.get());
+    if (c != EOF) ungetc(c, handle.get());
+    return c;
+}
+
+void fs::File::flush() {
+    if (handle) fflush(handle.get());
+}
+
+size_t fs::File::read(uint8_t* buffer, size_t size) {
+    return handle ? fread(buffer, 1, size, handle.get()) : 0;
+}
+
+bool fs::File::seek(uint32_t position, SeekMode mode) {
+    static const int origins[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+    return handle && fseek(handle.get(), position, origins[mode]) == 0;
+}
+
+size_t fs::File::position() const {
+    if (!handle) return 0;
+    long current = ftell(handle.get());
+    return current > 0 ? (size_t)current : 0;
+}
+
+size_t fs::File::size() const {
+    if (!handle) return 0;
+    fflush(handle.get());
+    struct stat info;
+    return fstat(fileno(handle.get()), &info) == 0 ? (size_t)info.st_size : 0;
+}
+
+// ============================================================================
+// FS
+// ============================================================================
+fs::File fs::FS::open(const char* path, const char* mode, bool create) {
+    if (root.empty()) return File();
+    
+    // Режими Arduino відповідають режимам stdio, але читання й запис
+    // файлу журналу — бінарні
+    std::string stdioMode = std::string(mode) + "b";
+    FILE* file = fopen(resolve(path).c_str(), stdioMode.c_str());
+    return file != nullptr ? File(file) : File();
+}
+
+bool fs::FS::exists(const char* path) {
+    struct stat info;
+    return !root.empty() && stat(resolve(path).c_str(), &info) == 0;
+}
+
+bool fs::FS::remove(const char* path) {
+    return !root.empty() && ::remove(resolve(path).c_str()) == 0;
+}
+
+bool fs::FS::rename(const char* from, const char* to) {
+    return !root.empty() && ::rename(resolve(from).c_str(), resolve(to).c_str()) == 0;
+}
+
+bool fs::LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles,
+                           const char* partitionLabel) {
+    const char* directory = NativeHal::getFilesystemRoot();
+    if (directory == nullptr) return false;
+    
+    struct stat info;
+    if (stat(directory, &info) != 0 && (!formatOnFail || mkdir(directory, 0755) != 0)) return false;
+    
+    root = directory;
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================================
+// NativeHal - Запуск прошивки на хості та сценарій входів
+// ============================================================================
+// main() із цієї бібліотеки викликає setup() і крутить loop(), як задача
+// loopTask на пристрої. Параметри командного рядка:
+//   --script <файл>       сценарій входів (формат нижче)
+//   --run-ms <мс>         тривалість прогону; 0 — до Ctrl+C
+//   --seed <n>            зерно esp_random()
+//   --fs <каталог>        корінь LittleFS; типово новий тимчасовий каталог
+//   --framebuffer <файл>  зберегти кадр дисплея в PPM після прогону
+//
+// Сценарій — рядки "<мс від старту> <команда> [аргументи]", # — коментар:
+//   1500 press 32         натиснути GPIO 32 і відпустити через 80 мс
+//   1500 press 32 400     утримувати 400 мс
+//   9000 level 26 0       виставити рівень лінії
+//   12000 wifi-loss 8     обрив Wi-Fi з кодом причини
+//   15000 serial config set mode dashboard
+//                         рядок у прийом Serial, як набраний у терміналі
+// Переривання викликаються з окремого потоку по черзі, як GPIO-ISR на ядрі
+namespace NativeHal {
+    typedef void (*ExitHook)();
+    
+    // Викликається після останньої ітерації loop(), перед виходом процесу
+    void onExit(ExitHook hook);
+    
+    // Виставляє рівень лінії і викликає обробник переривання за фронтом
+    void setPinLevel(int pin, int level);
+    
+    bool isFinished();
+    
+    // Додає рядок із '\n' у прийом Serial і викликає onReceive
+    void feedSerial(const char* text);
+    
+    // Потік задачі чекає (сокет, delay, сповіщення): для тік-хука
+    // xTaskGetCurrentTaskHandleForCPU() ядро в цей час у idle
+    class WaitScope {
+    public:
+        WaitScope();
+        ~WaitScope();
+    };
+    
+    // Внутрішні точки між частинами бібліотеки
+    void seedRandom(uint32_t seed);
+    void markHeapBaseline();
+    const char* getFilesystemRoot();
+    bool saveFramebuffer(const char* path);
+}
@@ -0,0 +1,246 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <signal.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "native_hal.h"
+
+void setup();
+void loop();
+
+// ============================================================================
+// Параметри прогону
+// ============================================================================
+namespace {
+    const unsigned long DEFAULT_PRESS_MS = 80;
+    const unsigned long SCRIPT_SETTLE_MS = 10000; // дати останньому запиту завершитись
+    const unsigned long HEAP_SAMPLE_MS = 2;
+    
+    struct Options {
+        const char* scriptPath = nullptr;
+        const char* framebufferPath = nullptr;
+        std::string filesystemRoot;
+        long runMs = -1;
+        uint32_t seed = 1;
+    };
+    
+    enum ActionType {
+        LEVEL_ACTION,
+        WIFI_LOSS_ACTION,
+        SERIAL_ACTION
+    };
+    
+    struct Action {
+        unsigned long at;
+        ActionType type;
+        int pin;
+        int value;
+        std::string text;
+    };
+    
+    Options options;
+    std::vector<NativeHal::ExitHook> exitHooks;
+    std::atomic<bool> finished(false);
+    
+#ifndef PIO_UNIT_TESTING
+    TaskHandle_t loopTask = nullptr;
+    
+    void usage(const char* program) {
+        fprintf(stderr,
+                "usage: %s [--script file] [--run-ms ms] [--seed n] [--fs dir] [--framebuffer file.ppm]\n",
+                program);
+    }
+    
+    bool parseOptions(int argc, char** argv) {
+        for (int i = 1; i < argc; i++) {
+            const char* name = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (value == nullptr) {
+                usage(argv[0]);
+                return false;
+            }
+            i++;
+            
+            if (strcmp(name, "--script") == 0) {
+                options.scriptPath = value;
+            } else if (strcmp(name, "--run-ms") == 0) {
+                options.runMs = atol(value);
+            } else if (strcmp(name, "--seed") == 0) {
+                options.seed = (uint32_t)strtoul(value, nullptr, 10);
+            } else if (strcmp(name, "--fs") == 0) {
+                options.filesystemRoot = value;
+            } else if (strcmp(name, "--framebuffer") == 0) {
+                options.framebufferPath = value;
+            } else {
+                usage(argv[0]);
+                return false;
+            }
+        }
+        
+        if (options.filesystemRoot.empty()) {
+            char directory[] = "/tmp/elevate-fs-XXXXXX";
+            if (mkdtemp(directory) == nullptr) return false;
+            options.filesystemRoot = directory;
+        }
+        return true;
+    }
+    
+    void finish() {
+        if (finished.exchange(true)) return;
+        if (loopTask != nullptr) xTaskNotifyGive(loopTask);
+    }
+    
+    // ========================================================================
+    // Сценарій входів
+    // ========================================================================
+    bool loadScript(const char* path, std::vector<Action>& actions) {
+        FILE* file = fopen(path, "r");
+        if (file == nullptr) {
+            fprintf(stderr, "cannot open script %s\n", path);
+            return false;
+        }
+        
+        char line[256];
+        int lineNumber = 0;
+        bool valid = true;
+        while (fgets(line, sizeof(line), file) != nullptr) {
+            lineNumber++;
+            char* comment = strchr(line, '#');
+            if (comment != nullptr) *comment = '\0';
+            
+            unsigned long at;
+            char command[16];
+            int first = 0;
+            int second = -1;
+            int textStart = 0;
+            int fields = sscanf(line, "%lu %15s %n%d %d", &at, command, &textStart, &first, &second);
+            if (fields <= 0) continue;
+            
+            if (fields >= 3 && strcmp(command, "press") == 0) {
+                unsigned long holdMs = second > 0 ? (unsigned long)second : DEFAULT_PRESS_MS;
+                actions.push_back({ at, LEVEL_ACTION, first, LOW, "" });
+                actions.push_back({ at + holdMs, LEVEL_ACTION, first, HIGH, "" });
+            } else if (fields == 4 && strcmp(command, "level") == 0) {
+                actions.push_back({ at, LEVEL_ACTION, first, second, "" });
+            } else if (fields >= 2 && strcmp(command, "wifi-loss") == 0) {
+                actions.push_back({ at, WIFI_LOSS_ACTION, 0, fields >= 3 ? first : 8, "" });
+            } else if (fields >= 2 && strcmp(command, "serial") == 0 && textStart > 0) {
+                // Решта рядка без кінцевих пробілів і переводу рядка
+                std::string text(line + textStart);
+                text.erase(text.find_last_not_of(" \t\r\n") + 1);
+                actions.push_back({ at, SERIAL_ACTION, 0, 0, text });
+            } else {
+                fprintf(stderr, "%s:%d: cannot parse '%s'\n", path, lineNumber, line);
+                valid = false;
+            }
+        }
+        fclose(file);
+        
+        std::stable_sort(actions.begin(), actions.end(),
+                         [](const Action& a, const Action& b) { return a.at < b.at; });
+        return valid;
+    }
+    
+    void runScript(std::vector<Action> actions) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now() - std::chrono::milliseconds(millis());
+        
+        for (size_t i = 0; i < actions.size() && !finished; i++) {
+            const Action& action = actions[i];
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(action.at));
+            
+            if (action.type == LEVEL_ACTION) {
+                NativeHal::setPinLevel(action.pin, action.value);
+            } else if (action.type == SERIAL_ACTION) {
+                NativeHal::feedSerial(action.text.c_str());
+            } else {
+                WiFi.simulateLoss((uint8_t)action.value);
+            }
+        }
+    }
+    
+    void stopAfter(unsigned long runMs) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(runMs > millis() ? runMs - millis() : 0));
+        finish();
+    }
+    
+    // На пристрої мінімум вільної купи веде сам алокатор; тут його
+    // доводиться вибирати, інакше короткі піки між звітами не видно
+    void sampleHeap() {
+        while (!finished) {
+            ESP.getFreeHeap();
+            std::this_thread::sleep_for(std::chrono::milliseconds(HEAP_SAMPLE_MS));
+        }
+    }
+    
+    // Ctrl+C завершує прогін так само, як і --run-ms: зі звітом
+    void waitForSignal(sigset_t signals) {
+        int signal;
+        sigwait(&signals, &signal);
+        finish();
+    }
+#endif
+}
+
+// ============================================================================
+// NativeHal
+// ============================================================================
+void NativeHal::onExit(ExitHook hook) {
+    exitHooks.push_back(hook);
+}
+
+bool NativeHal::isFinished() {
+    return finished;
+}
+
+const char* NativeHal::getFilesystemRoot() {
+    return options.filesystemRoot.c_str();
+}
+
+// У модульних тестах (pio test -e native) main() дає сам тест,
+// а setup() і loop() не викликаються
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+    if (!parseOptions(argc, argv)) return 2;
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    
+    // Сигнали блокуються до створення будь-яких потоків і приймаються одним
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::thread(waitForSignal, signals).detach();
+    
+    std::vector<Action> actions;
+    if (options.scriptPath != nullptr && !loadScript(options.scriptPath, actions)) return 2;
+    
+    long runMs = options.runMs;
+    if (runMs < 0 && !actions.empty()) runMs = actions.back().at + SCRIPT_SETTLE_MS;
+    if (runMs > 0) std::thread(stopAfter, (unsigned long)runMs).detach();
+    
+    NativeHal::seedRandom(options.seed);
+    NativeHal::markHeapBaseline();
+    std::thread(sampleHeap).detach();
+    loopTask = xTaskGetCurrentTaskHandle();
+    if (!actions.empty()) std::thread(runScript, actions).detach();
+    
+    setup();
+    while (!finished) {
+        loop();
+    }
+    
+    for (size_t i = 0; i < exitHooks.size(); i++) exitHooks[i]();
+    if (options.framebufferPath != nullptr && !NativeHal::saveFramebuffer(options.framebufferPath)) {
+        fprintf(stderr, "cannot write framebuffer %s\n", options.framebufferPath);
+    }
+    
+    // Мережева задача може бути посеред запиту — не чекаємо на неї
+    fflush(stdout);
+    _exit(0);
+}
+#endif
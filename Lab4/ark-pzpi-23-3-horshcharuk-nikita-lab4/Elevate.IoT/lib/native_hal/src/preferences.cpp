@@ -0,0 +1,163 @@
+#include <Preferences.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Простори імен NVS
+// ============================================================================
+namespace {
+    enum ValueType : uint8_t {
+        U8_TYPE,
+        I32_TYPE,
+        U32_TYPE,
+        STRING_TYPE,
+        BLOB_TYPE
+    };
+    
+    struct Value {
+        uint8_t type;
+        std::vector<uint8_t> bytes;
+    };
+    
+    typedef std::map<std::string, Value> Namespace;
+    
+    // Ключі NVS обмежені 15 символами, як на пристрої
+    const size_t MAX_KEY_LENGTH = 15;
+    
+    std::mutex storageMutex;
+    std::map<std::string, Namespace> storage;
+    
+    bool isValidKey(const char* key) {
+        return key != nullptr && key[0] != '\0' && strlen(key) <= MAX_KEY_LENGTH;
+    }
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partition) {
+    if (!isValidKey(name)) return false;
+    
+    std::lock_guard<std::mutex> lock(storageMutex);
+    space = &storage[name];
+    this->readOnly = readOnly;
+    return true;
+}
+
+void Preferences::end() {
+    space = nullptr;
+}
+
+bool Preferences::clear() {
+    if (space == nullptr || readOnly) return false;
+    
+    std::lock_guard<std::mutex> lock(storageMutex);
+    ((Namespace*)space)->clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (space == nullptr || readOnly || !isValidKey(key)) return false;
+    
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return ((Namespace*)space)->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    if (space == nullptr || !isValidKey(key)) return false;
+    
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return ((Namespace*)space)->count(key) > 0;
+}
+
+size_t Preferences::putValue(const char* key, uint8_t type, const void* value, size_t length) {
+    if (space == nullptr || readOnly || !isValidKey(key)) return 0;
+    
+    std::lock_guard<std::mutex> lock(storageMutex);
+    Value& stored = (*(Namespace*)space)[key];
+    stored.type = type;
+    stored.bytes.assign((const uint8_t*)value, (const uint8_t*)value + length);
+    return length;
+}
+
+// Повертає довжину збереженого значення або 0, якщо ключа немає,
+// тип інший чи буфер замалий
+size_t Preferences::getValue(const char* key, uint8_t type, void* value, size_t length) {
+    if (space == nullptr || !isValidKey(key)) return 0;
+    
+    std::lock_guard<std::mutex> lock(storageMutex);
+    Namespace& values = *(Namespace*)space;
+    Namespace::iterator found = values.find(key);
+    if (found == values.end() || found->second.type != type) return 0;
+    
+    const std::vector<uint8_t>& bytes = found->second.bytes;
+    if (value != nullptr) {
+        if (bytes.size() > length) return 0;
+        memcpy(value, bytes.data(), bytes.size());
+    }
+    return bytes.size();
+}
+
+size_t Preferences::putUChar(const char* key, uint8_t value) {
+    return putValue(key, U8_TYPE, &value, sizeof(value));
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+    return putUChar(key, value ? 1 : 0);
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+    return putValue(key, I32_TYPE, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+    return putValue(key, U32_TYPE, &value, sizeof(value));
+}
+
+size_t Preferences::putULong(const char* key, uint32_t value) {
+    return putUInt(key, value);
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    return value != nullptr ? putValue(key, STRING_TYPE, value, strlen(value) + 1) : 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    return value != nullptr ? putValue(key, BLOB_TYPE, value, length) : 0;
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) {
+    uint8_t value = defaultValue;
+    return getValue(key, U8_TYPE, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+    return getUChar(key, defaultValue ? 1 : 0) != 0;
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+    int32_t value = defaultValue;
+    return getValue(key, I32_TYPE, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+    uint32_t value = defaultValue;
+    return getValue(key, U32_TYPE, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+}
+
+uint32_t Preferences::getULong(const char* key, uint32_t defaultValue) {
+    return getUInt(key, defaultValue);
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLength) {
+    if (value == nullptr) return getValue(key, STRING_TYPE, nullptr, 0);
+    return getValue(key, STRING_TYPE, value, maxLength);
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    return getValue(key, BLOB_TYPE, nullptr, 0);
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    if (buffer == nullptr) return 0;
+    return getValue(key, BLOB_TYPE, buffer, maxLength);
+}
@@ -0,0 +1,252 @@
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "native_hal.h"
+
+WiFiClass WiFi;
+
+// ============================================================================
+// WiFiClass
+// ============================================================================
+namespace {
+    const int CONNECT_TIMEOUT_MS = 3000;
+    
+    std::mutex eventMutex;
+    std::vector<WiFiEventCb> eventHandlers;
+    uint8_t bssid[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+    
+    // Події доставляються окремим потоком, як задачею подій на пристрої
+    void dispatch(WiFiEvent_t event, WiFiEventInfo_t info) {
+        std::vector<WiFiEventCb> handlers;
+        {
+            std::lock_guard<std::mutex> lock(eventMutex);
+            handlers = eventHandlers;
+        }
+        std::thread([handlers, event, info]() {
+            for (size_t i = 0; i < handlers.size(); i++) handlers[i](event, info);
+        }).detach();
+    }
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb callback, WiFiEvent_t event) {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    eventHandlers.push_back(callback);
+    return (wifi_event_id_t)eventHandlers.size();
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel,
+                             const uint8_t* bssid, bool connect) {
+    if (!connect) return currentStatus;
+    
+    currentStatus = WL_CONNECTED;
+    WiFiEventInfo_t info = {};
+    dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP, info);
+    return currentStatus;
+}
+
+bool WiFiClass::config(IPAddress localIp, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    staticIp = localIp;
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+    simulateLoss();
+    return true;
+}
+
+void WiFiClass::simulateLoss(uint8_t reason) {
+    if (currentStatus != WL_CONNECTED) return;
+    
+    currentStatus = WL_DISCONNECTED;
+    WiFiEventInfo_t info = {};
+    memcpy(info.wifi_sta_disconnected.bssid, ::bssid, sizeof(::bssid));
+    info.wifi_sta_disconnected.channel = 1;
+    info.wifi_sta_disconnected.reason = reason;
+    dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+}
+
+IPAddress WiFiClass::localIP() {
+    if (currentStatus != WL_CONNECTED) return IPAddress();
+    return (uint32_t)staticIp != 0 ? staticIp : IPAddress(127, 0, 0, 1);
+}
+
+uint8_t* WiFiClass::BSSID() {
+    return currentStatus == WL_CONNECTED ? ::bssid : nullptr;
+}
+
+// ============================================================================
+// esp_wifi
+// ============================================================================
+namespace {
+    wifi_config_t staConfig = {};
+}
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* config) {
+    if (interface != WIFI_IF_STA) return ESP_FAIL;
+    *config = staConfig;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* config) {
+    if (interface != WIFI_IF_STA) return ESP_FAIL;
+    staConfig = *config;
+    return ESP_OK;
+}
+
+// Асоціація та сама, що й у WiFi.begin() з connect = true
+esp_err_t esp_wifi_connect() {
+    WiFi.begin(nullptr);
+    return ESP_OK;
+}
+
+// ============================================================================
+// WiFiClient
+// ============================================================================
+int WiFiClient::connect(const char* host, uint16_t port) {
+    stop();
+    
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = nullptr;
+    char service[8];
+    snprintf(service, sizeof(service), "%u", port);
+    if (getaddrinfo(host, service, &hints, &addresses) != 0 || addresses == nullptr) return 0;
+    
+    int socketFd = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+    if (socketFd < 0) {
+        freeaddrinfo(addresses);
+        return 0;
+    }
+    
+    // Неблокуюче з'єднання з тайм-аутом замість системних хвилин
+    fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL, 0) | O_NONBLOCK);
+    int result = ::connect(socketFd, addresses->ai_addr, addresses->ai_addrlen);
+    freeaddrinfo(addresses);
+    
+    if (result < 0 && errno == EINPROGRESS) {
+        struct pollfd pending = { socketFd, POLLOUT, 0 };
+        NativeHal::WaitScope wait;
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (poll(&pending, 1, CONNECT_TIMEOUT_MS) == 1 &&
+            getsockopt(socketFd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0) {
+            result = 0;
+        }
+    }
+    if (result < 0) {
+        close(socketFd);
+        return 0;
+    }
+    
+    fd = socketFd;
+    rxStart = rxEnd = 0;
+    setNoDelay(true);
+    return 1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port);
+}
+
+void WiFiClient::stop() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+    rxStart = rxEnd = 0;
+}
+
+// Як і lwIP, з'єднання вважається живим, поки є непрочитані дані
+uint8_t WiFiClient::connected() {
+    if (fd < 0) return rxStart < rxEnd ? 1 : 0;
+    if (rxStart < rxEnd) return 1;
+    
+    uint8_t probe;
+    ssize_t result = recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (result > 0) return 1;
+    if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 1;
+    
+    close(fd);
+    fd = -1;
+    return 0;
+}
+
+void WiFiClient::setNoDelay(bool noDelay) {
+    if (fd < 0) return;
+    int flag = noDelay ? 1 : 0;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (fd < 0) return 0;
+    
+    size_t written = 0;
+    while (written < size) {
+        ssize_t result = send(fd, buffer + written, size - written, MSG_NOSIGNAL);
+        if (result > 0) {
+            written += result;
+            continue;
+        }
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd output = { fd, POLLOUT, 0 };
+            NativeHal::WaitScope wait;
+            if (poll(&output, 1, (int)_timeout) == 1) continue;
+        }
+        stop();
+        break;
+    }
+    return written;
+}
+
+// Дочитує наступний сегмент у буфер; timeoutMs = 0 — без очікування
+bool WiFiClient::fill(int timeoutMs) {
+    if (rxStart < rxEnd) return true;
+    if (fd < 0) return false;
+    
+    if (timeoutMs > 0) {
+        struct pollfd input = { fd, POLLIN, 0 };
+        NativeHal::WaitScope wait;
+        if (poll(&input, 1, timeoutMs) <= 0) return false;
+    }
+    
+    ssize_t result = recv(fd, rxBuffer, RX_BUFFER_SIZE, MSG_DONTWAIT);
+    if (result > 0) {
+        rxStart = 0;
+        rxEnd = result;
+        return true;
+    }
+    if (result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        close(fd);
+        fd = -1;
+    }
+    return false;
+}
+
+bool WiFiClient::waitAvailable(unsigned long timeoutMs) {
+    return fill((int)timeoutMs);
+}
+
+int WiFiClient::available() {
+    if (!fill(0)) return 0;
+    return (int)(rxEnd - rxStart);
+}
+
+int WiFiClient::read() {
+    if (!fill(0)) return -1;
+    return rxBuffer[rxStart++];
+}
+
+int WiFiClient::peek() {
+    if (!fill(0)) return -1;
+    return rxBuffer[rxStart];
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// BadgeTable - Згенеровано tools/gen_badge_table.py, не редагувати вручну
+// ============================================================================
+namespace BadgeTable {
+    constexpr unsigned int CARD_COUNT = 3;
+    constexpr unsigned int SLOT_COUNT = 8;
+    constexpr unsigned int MAX_PROBE = 1;
+
+    const uint64_t KEYS[SLOT_COUNT] = {
+        0x0000000000000000ULL, 0x0000000000000000ULL, 0x0404172839000000ULL, 0x0404A1B2C3000000ULL,
+        0x0000000000000000ULL, 0x0404D4E5F6000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    };
+
+    const uint32_t USER_IDS[SLOT_COUNT] = {
+        0, 0, 3, 1, 0, 2, 0, 0,
+    };
+}
@@ -12,20 +12,110 @@ namespace Hardware {
     constexpr int BUTTON_USER2 = 33;
     constexpr int BUTTON_USER3 = 25;
     constexpr int BUTTON_LEADERBOARD = 26;
+    
+    constexpr int RFID_SS = 5;
+    constexpr int RFID_RST = 27;
+    constexpr int RFID_IRQ = 35; // лише вхід, без підтяжки: IRQ зчитувача push-pull
 }
 
 namespace Timing {
     constexpr unsigned long BUTTON_DEBOUNCE_MS = 200;
-    constexpr unsigned long BUTTON_PRESS_CHECK_DELAY_MS = 50;
+    constexpr unsigned long BUTTON_SETTLE_MS = 30;
+    constexpr unsigned long RFID_ACTIVATE_INTERVAL_MS = 100;
+    constexpr unsigned long RFID_IDLE_INTERVAL_MS = 500;
+    constexpr unsigned long RFID_REPEAT_MS = 2000;
     constexpr unsigned long WIFI_RETRY_INTERVAL_MS = 5000;
-    constexpr unsigned long WIFI_CONNECT_DELAY_MS = 300;
-    constexpr unsigned long WIFI_MAX_ATTEMPTS = 15;
     constexpr unsigned long HTTP_TIMEOUT_MS = 10000;
     constexpr unsigned long SCAN_RESULT_DISPLAY_MS = 7000;
-    constexpr unsigned long WAITING_MESSAGE_INTERVAL_MS = 5000;
-    constexpr unsigned long WIFI_CHECK_INTERVAL_MS = 10000;
-    constexpr unsigned long LOOP_DELAY_MS = 100;
+    constexpr unsigned long LEADERBOARD_DISPLAY_MS = 2000;
+    constexpr unsigned long SYSTEM_STATUS_DISPLAY_MS = 5000;
+    constexpr unsigned long DIAGNOSTICS_DISPLAY_MS = 15000;
+    constexpr unsigned long TIMER_MISS_TOLERANCE_MS = 10;
     constexpr unsigned long DASHBOARD_UPDATE_INTERVAL_MS = 10000;
+    constexpr unsigned long DASHBOARD_MIN_INTERVAL_MS = 2000;
+    constexpr unsigned long DASHBOARD_MAX_INTERVAL_MS = 120000;
+    constexpr unsigned long DASHBOARD_JITTER_PERCENT = 10;
+    constexpr unsigned long STATUS_REPORT_INTERVAL_MS = 60000;
+    constexpr unsigned long STREAM_SERVICE_MS = 50;
+    constexpr unsigned long STREAM_RETRY_MS = 15000;
+    constexpr unsigned long STREAM_IDLE_TIMEOUT_MS = 45000;
+    constexpr unsigned long JOURNAL_RETRY_MIN_MS = 5000;
+    constexpr unsigned long JOURNAL_RETRY_MAX_MS = 300000;
+}
+
+namespace Tasks {
+    constexpr int NETWORK_CORE = 0;
+    constexpr int NETWORK_PRIORITY = 1;
+    constexpr unsigned int NETWORK_STACK_SIZE = 8192;
+    constexpr int JOB_QUEUE_LENGTH = 4;
+    constexpr int RESULT_QUEUE_LENGTH = 4;
+}
+
+namespace Power {
+    constexpr int MAX_CPU_MHZ = 240;
+    constexpr int MIN_CPU_MHZ = 80;
+    constexpr unsigned long LIGHT_SLEEP_MIN_MS = 3;  // CONFIG_FREERTOS_IDLE_TIME_BEFORE_SLEEP
+    constexpr uint16_t WIFI_LISTEN_INTERVAL = 3;     // маяків між прокиданнями радіо (~307 мс)
+    constexpr unsigned long RFID_IDLE_AFTER_MS = 30000;
+    // Струм модуля без дисплея для оцінки, мкА (даташит ESP32)
+    constexpr uint32_t ACTIVE_UA = 50000;      // CPU 240 МГц, радіо в modem sleep
+    constexpr uint32_t IDLE_UA = 25000;        // CPU чекає переривання, радіо в modem sleep
+    constexpr uint32_t LIGHT_SLEEP_UA = 800;
+    constexpr int UART_WAKE_THRESHOLD = 3;     // фронтів до пробудження; ці символи губляться
+    constexpr unsigned long CONSOLE_AWAKE_MS = 30000;
+}
+
+namespace Input {
+    constexpr unsigned int EVENT_QUEUE_LENGTH = 16;
+}
+
+namespace Badges {
+    constexpr int MAX_UID_LENGTH = 7;
+    constexpr int UID_HEX_LENGTH = MAX_UID_LENGTH * 2;
+    constexpr int CARD_CACHE_SIZE = 16;
+}
+
+namespace Profiles {
+    constexpr int CACHE_SIZE = 8;
+}
+
+namespace Journal {
+    constexpr const char* FILE_PATH = "/scans.log";
+    constexpr const char* TEMP_FILE_PATH = "/scans.tmp";
+    constexpr unsigned int MAX_RECORDS = 512;
+    constexpr int DRAIN_BATCH_SIZE = 8;
+}
+
+namespace Parsing {
+    constexpr unsigned int JSON_POOL_SIZE = 6144;
+    constexpr unsigned int ERROR_BODY_LENGTH = 128;
+    constexpr unsigned int REQUEST_BODY_LENGTH = 128;
+    constexpr unsigned int ETAG_LENGTH = 64;
+    constexpr unsigned int LEADERBOARD_BODY_LENGTH = 1536;
+    constexpr unsigned int STREAM_EVENT_LENGTH = 16;
+    constexpr unsigned int STREAM_DATA_LENGTH = 1024;
+    constexpr unsigned int HOST_LENGTH = 64;
+    constexpr unsigned int URL_LENGTH = 224;          // база, шлях і ключ пристрою
+    constexpr unsigned int CONTENT_TYPE_LENGTH = 48;
+}
+
+namespace Provisioning {
+    constexpr const char* NVS_NAMESPACE = "config";
+    constexpr const char* NVS_KEY = "settings";
+    constexpr uint16_t FORMAT_VERSION = 1;
+    constexpr int SSID_LENGTH = 32;
+    constexpr int PASSWORD_LENGTH = 64;
+    constexpr int URL_LENGTH = 96;
+    constexpr int DEVICE_KEY_LENGTH = 48;
+    constexpr unsigned int CONSOLE_LINE_LENGTH = 160;
+    constexpr unsigned long MIN_INTERVAL_MS = 1000;
+    constexpr unsigned long MAX_INTERVAL_MS = 1800000; // межа таймерів Scheduler
+}
+
+namespace Latency {
+    constexpr int BUCKET_COUNT = 24;
+    constexpr int CALIBRATION_ROUNDS = 1000;
+    constexpr uint32_t OVERHEAD_BUDGET_CYCLES = 200;
 }
 
 namespace Display {
@@ -33,16 +123,37 @@ namespace Display {
     constexpr int MAX_LEVEL_LENGTH = 15;
     constexpr int MAX_BADGE_LENGTH = 15;
     constexpr int MAX_ERROR_LINE_LENGTH = 25;
+    constexpr int MAX_ERROR_MESSAGE_LENGTH = 96;
+    constexpr int MAX_LINE_LENGTH = 53;
+    constexpr int MAX_TEXT_SLOTS = 12;
+    constexpr int CANVAS_STRIP_WIDTH = 320;
+    constexpr int CANVAS_STRIP_HEIGHT = 16;
+    constexpr int LINE_BUFFER_WIDTH = 320; // рядок пікселів для виводу з атласу
     constexpr int MAX_LEADERBOARD_NAME_LENGTH = 12;
     constexpr int MAX_LEADERBOARD_ENTRIES = 5;
+    constexpr int FOOTER_Y = 225; // рядок опитування внизу екрана дашборда
     constexpr int MAX_RECENT_BADGES = 5;
 }
 
+// Значення за замовчуванням; робочі налаштування ConfigManager читає з NVS
 namespace Config {
     constexpr const char* WIFI_SSID = "Wokwi-GUEST";
     constexpr const char* WIFI_PASSWORD = "";
+#ifdef ELEVATE_NATIVE
+    // env:native ходить до tools/backend_stub.py на тому ж хості
+    constexpr const char* API_BASE_URL = "http://127.0.0.1:5181";
+#else
     constexpr const char* API_BASE_URL = "http://192.168.0.77:5181";
+#endif
     constexpr const char* DEVICE_KEY = "device-backend-001";
+    constexpr bool START_IN_DASHBOARD = false;
+    // Бекенд поки не має /api/iot/leaderboard/stream, тому типово опитування
+    constexpr bool LEADERBOARD_STREAM = false;
+    // Автоматичний light sleep у простої; пробуджують кнопки, RFID, таймери та радіо
+    constexpr bool LIGHT_SLEEP_IDLE = true;
+    // Повторно використовувати останню адресу DHCP як статичну. Пришвидшує
+    // перепідключення, але лише для мереж, де оренда закріплена за пристроєм
+    constexpr bool WIFI_REUSE_LEASE = false;
 }
 
 namespace Users {
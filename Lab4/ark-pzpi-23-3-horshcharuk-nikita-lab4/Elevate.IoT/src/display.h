@@ -4,5 +4,10 @@
 #include <Adafruit_ILI9341.h>
 #include "constants.h"
 
+// Режим рендерингу обирається під час збірки: з -D ELEVATE_CANVAS_RENDER
+// рядки складаються в буфері GFXcanvas16 і передаються одним вікном,
+// без прапорця кожен рядок пікселів збирається з атласу гліфів
+// (GlyphAtlas) і теж іде одним вікном; drawChar() бібліотеки GFX
+// лишається запасним шляхом для порівняння в env renderbench
 extern Adafruit_ILI9341 display;
 
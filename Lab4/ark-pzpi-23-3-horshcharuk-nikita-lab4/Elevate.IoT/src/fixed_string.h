@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+// ============================================================================
+// FixedString - Рядок фіксованої ємності без виділення пам'яті в купі
+// ============================================================================
+// Текст, довший за ємність, обрізається, а прапорець isTruncated()
+// дозволяє екрану дописати "..."
+template <size_t Capacity>
+class FixedString {
+private:
+    char buffer[Capacity + 1];
+    uint16_t len;
+    bool truncated;
+    
+public:
+    FixedString() : len(0), truncated(false) {
+        buffer[0] = '\0';
+    }
+    
+    FixedString(const char* text) : FixedString() {
+        append(text);
+    }
+    
+    FixedString& operator=(const char* text) {
+        assign(text);
+        return *this;
+    }
+    
+    void clear() {
+        len = 0;
+        truncated = false;
+        buffer[0] = '\0';
+    }
+    
+    void assign(const char* text, size_t maxLen = Capacity) {
+        clear();
+        append(text, maxLen);
+    }
+    
+    void append(const char* text, size_t maxLen = Capacity) {
+        if (text == nullptr) return;
+        
+        size_t limit = min(maxLen, Capacity);
+        while (*text != '\0') {
+            if (len >= limit) {
+                truncated = true;
+                break;
+            }
+            buffer[len++] = *text++;
+        }
+        buffer[len] = '\0';
+    }
+    
+    void format(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        int written = vsnprintf(buffer, Capacity + 1, fmt, args);
+        va_end(args);
+        
+        if (written < 0) {
+            clear();
+            return;
+        }
+        len = min((size_t)written, Capacity);
+        truncated = (size_t)written > Capacity;
+    }
+    
+    const char* c_str() const { return buffer; }
+    size_t length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    bool isTruncated() const { return truncated; }
+    static size_t capacity() { return Capacity; }
+    
+    bool operator==(const char* text) const { return strcmp(buffer, text) == 0; }
+    bool operator!=(const char* text) const { return !(*this == text); }
+};
@@ -5,12 +5,33 @@
  * Платформа: ESP32
  * 
  * Архітектура:
- * - ConfigManager: управління налаштуваннями
+ * - ConfigManager: налаштування з NVS зі значеннями за замовчуванням
+ * - ConfigConsole: зміна налаштувань через Serial без перепрошивки
  * - WiFiManager: підключення до Wi-Fi
  * - ApiClient: HTTP комунікація з сервером
- * - BadgeReader: зчитування бейджів (кнопки)
+ * - LeaderboardStream: оновлення лідерборду через SSE
+ * - DashboardPoller: адаптивний інтервал опитування з джитером
+ * - NetworkWorker: фонова задача мережевих запитів (ядро 0)
+ * - ScanJournal: журнал невідправлених сканувань у LittleFS
+ * - Scheduler: таймери з дедлайнами, loop() спить між ними
+ * - PowerManager: автоматичний light sleep у простої між подіями
+ * - InputEvents: натискання кнопок через переривання
+ * - BadgeReader: зчитування бейджів (кнопки та RFID)
+ * - RfidReader: зчитувач MFRC522 з перериванням IRQ
+ * - BadgeDirectory: таблиця UID -> userId у флеші та кеш у NVS
+ * - ProfileCache: LRU-кеш профілів для миттєвого показу
  * - LedDisplay: відображення інформації (TFT ILI9341)
+ * - RetainedScreen: перемальовування лише змінених рядків екрана
+ * - GlyphAtlas: растризований шрифт для виводу рядка одним вікном
  * - CoreLogic: головна бізнес-логіка
+ * - StatusReport: звіт лічильників у Serial
+ * - BootTrace: час фаз запуску в Serial
+ * - LatencyStats: гістограми затримок етапів сканування
+ * - CoreLoad: завантаження ядер за вибірками з тіку
+ * - WireBenchmark: порівняння JSON та MessagePack (env wirebench)
+ * - RenderBenchmark: текст через GFX проти атласу (env renderbench)
+ *
+ * env:native збирає ці ж модулі для Linux поверх lib/native_hal
  */
 
 #include <SPI.h>
@@ -20,10 +41,31 @@
 #include "modules/config_manager.h"
 #include "modules/wifi_manager.h"
 #include "modules/api_client.h"
+#include "modules/scan_journal.h"
+#include "modules/leaderboard_stream.h"
+#include "modules/dashboard_poller.h"
+#include "modules/network_worker.h"
+#include "modules/scheduler.h"
+#include "modules/boot_trace.h"
+#include "modules/latency_stats.h"
+#include "modules/core_load.h"
+#include "modules/input_events.h"
+#include "modules/badge_directory.h"
+#include "modules/rfid_reader.h"
 #include "modules/badge_reader.h"
 #include "modules/leaderboard_button.h"
+#include "modules/retained_screen.h"
+#include "modules/profile_cache.h"
 #include "modules/led_display.h"
 #include "modules/core_logic.h"
+#include "modules/config_console.h"
+#include "modules/power_manager.h"
+#include "modules/status_report.h"
+#include "modules/wire_benchmark.h"
+#include "modules/render_benchmark.h"
+#ifdef ELEVATE_NATIVE
+#include "native_hal.h"
+#endif
 
 // ============================================================================
 // Глобальні змінні
@@ -37,98 +79,330 @@ const char* ConfigManager::API_BASE_URL = Config::API_BASE_URL;
 const char* ConfigManager::DEVICE_KEY = Config::DEVICE_KEY;
 ConfigManager::Mode ConfigManager::currentMode = ConfigManager::SCAN_MODE;
 unsigned long ConfigManager::dashboardUpdateInterval = Timing::DASHBOARD_UPDATE_INTERVAL_MS;
+ConfigManager::UpdateMode ConfigManager::updateMode = ConfigManager::POLL_UPDATES;
+bool ConfigManager::lightSleepIdle = true;
+ConfigManager::Settings ConfigManager::stored;
+ConfigManager::Settings ConfigManager::draft;
+char ConfigManager::apiBaseUrl[Provisioning::URL_LENGTH + 1];
+char ConfigManager::deviceKey[Provisioning::DEVICE_KEY_LENGTH + 1];
+volatile bool ConfigManager::backendPending = false;
+bool ConfigManager::loadedFromNvs = false;
+unsigned long ConfigManager::loadMicros = 0;
+unsigned long ConfigManager::saves = 0;
 
+WiFiManager::LinkCache WiFiManager::cache;
 unsigned long WiFiManager::lastConnectionAttempt = 0;
-bool WiFiManager::connectionStatus = false;
+volatile bool WiFiManager::connected = false;
+volatile bool WiFiManager::linkUp = false;
+volatile bool WiFiManager::reconnectPending = false;
+volatile bool WiFiManager::cacheRejected = false;
+volatile bool WiFiManager::fastJoin = false;
+volatile bool WiFiManager::outagePending = false;
+volatile unsigned long WiFiManager::joinStartedAt = 0;
+volatile unsigned long WiFiManager::lostAt = 0;
+unsigned long WiFiManager::joins = 0;
+unsigned long WiFiManager::fastJoins = 0;
+unsigned long WiFiManager::lastJoinMs = 0;
+unsigned long WiFiManager::losses = 0;
+unsigned long WiFiManager::lastOutageMs = 0;
+unsigned long WiFiManager::totalOutageMs = 0;
+unsigned long WiFiManager::outages = 0;
+uint8_t WiFiManager::lastReason = 0;
+unsigned long WiFiManager::lossHistogram[WiFiManager::LOSS_BUCKETS];
+
+SpscRing<InputEvent, Input::EVENT_QUEUE_LENGTH> InputEvents::events;
+int InputEvents::pins[InputEvents::SOURCE_COUNT];
+volatile unsigned long InputEvents::lastPressTime[InputEvents::SOURCE_COUNT];
+volatile unsigned long InputEvents::lastReleaseTime[InputEvents::SOURCE_COUNT];
+volatile unsigned long InputEvents::droppedEvents = 0;
+volatile unsigned long InputEvents::coalescedEvents = 0;
+size_t InputEvents::peakPendingEvents = 0;
+volatile uint8_t InputEvents::awaitedLevels[InputEvents::SOURCE_COUNT];
+
+BadgeDirectory::CachedCard BadgeDirectory::cache[Badges::CARD_CACHE_SIZE];
+int BadgeDirectory::nextCacheSlot = 0;
+unsigned long BadgeDirectory::lookups = 0;
+unsigned long BadgeDirectory::tableHits = 0;
+unsigned long BadgeDirectory::cacheHits = 0;
+unsigned long BadgeDirectory::misses = 0;
+unsigned long BadgeDirectory::lastLookupMicros = 0;
+unsigned long BadgeDirectory::maxLookupMicros = 0;
+
+MFRC522 RfidReader::reader(Hardware::RFID_SS, Hardware::RFID_RST);
+bool RfidReader::present = false;
+uint64_t RfidReader::lastCardKey = 0;
+unsigned long RfidReader::lastCardTime = 0;
+unsigned long RfidReader::cardsRead = 0;
+unsigned long RfidReader::repeatedCards = 0;
+unsigned long RfidReader::readErrors = 0;
 
 bool BadgeReader::isInitialized = false;
-unsigned long BadgeReader::lastButtonPressTime = 0;
 int BadgeReader::lastReadUserId = 0;
+uint64_t BadgeReader::unresolvedCardKey = 0;
 
 bool LeaderboardButton::isInitialized = false;
-unsigned long LeaderboardButton::lastButtonPressTime = 0;
-bool LeaderboardButton::wasPressed = false;
 
 bool LedDisplay::isDisplayInitialized = false;
 unsigned long LedDisplay::startTime = 0;
 int LedDisplay::successfulScans = 0;
 int LedDisplay::failedScans = 0;
+int LedDisplay::loadingBarWidth = 0;
+LedDisplay::ApiState LedDisplay::apiState = LedDisplay::API_UNKNOWN;
+
+RetainedScreen::Slot RetainedScreen::slots[Display::MAX_TEXT_SLOTS];
+RetainedScreen::Screen RetainedScreen::currentScreen = RetainedScreen::NO_SCREEN;
+unsigned long RetainedScreen::framePixels = 0;
+unsigned long RetainedScreen::lastFramePixels = 0;
+unsigned long RetainedScreen::totalPixels = 0;
+unsigned long RetainedScreen::frameCount = 0;
+unsigned long RetainedScreen::frameStartMicros = 0;
+uint32_t RetainedScreen::frameStartCycles = 0;
+uint32_t RetainedScreen::flushCycles = 0;
+unsigned long RetainedScreen::lastFrameMicros[RetainedScreen::SCREEN_COUNT];
+unsigned long RetainedScreen::maxFrameMicros[RetainedScreen::SCREEN_COUNT];
+#ifdef ELEVATE_CANVAS_RENDER
+GFXcanvas16 RetainedScreen::strip(Display::CANVAS_STRIP_WIDTH, Display::CANVAS_STRIP_HEIGHT);
+#else
+bool RetainedScreen::glyphAtlas = false;
+uint16_t RetainedScreen::lineBuffer[Display::LINE_BUFFER_WIDTH];
+#endif
+
+uint8_t GlyphAtlas::rows[GlyphAtlas::GLYPH_COUNT][GlyphAtlas::GLYPH_HEIGHT];
+bool GlyphAtlas::built = false;
+unsigned long GlyphAtlas::buildMicros = 0;
 
-unsigned long CoreLogic::lastDashboardUpdate = 0;
-unsigned long CoreLogic::lastWaitingMessage = 0;
+ProfileCache::Entry ProfileCache::entries[Profiles::CACHE_SIZE];
+unsigned long ProfileCache::useCounter = 0;
+unsigned long ProfileCache::hits = 0;
+unsigned long ProfileCache::misses = 0;
+unsigned long ProfileCache::evictions = 0;
+uint64_t ProfileCache::cachedFirstPixelMicros = 0;
+unsigned long ProfileCache::cachedSamples = 0;
+uint64_t ProfileCache::uncachedFirstPixelMicros = 0;
+unsigned long ProfileCache::uncachedSamples = 0;
+
+CoreLogic::UiState CoreLogic::uiState = CoreLogic::IDLE_STATE;
+int CoreLogic::pendingRequests = 0;
+int CoreLogic::provisionalUserId = 0;
+unsigned long CoreLogic::skippedRedraws = 0;
+unsigned long CoreLogic::journalBackoffMs = 0;
+unsigned long CoreLogic::lastScanResultAt = 0;
+uint8_t CoreLogic::configChanges = 0;
 
 HTTPClient ApiClient::http;
+WiFiClient ApiClient::client;
+unsigned long ApiClient::reusedConnections = 0;
+unsigned long ApiClient::newConnections = 0;
+unsigned long ApiClient::staleReconnects = 0;
+JsonPool ApiClient::parsePool;
+unsigned long ApiClient::lastParseMicros = 0;
+unsigned long ApiClient::maxParseMicros = 0;
+unsigned long ApiClient::lastBodyBytes = 0;
+uint32_t ApiClient::lastBodyHash = 0;
+FixedString<Parsing::ETAG_LENGTH> ApiClient::leaderboardEtag;
+uint32_t ApiClient::leaderboardHash = 0;
+unsigned long ApiClient::leaderboardBytes = 0;
+LeaderboardEntry ApiClient::cachedLeaderboard[Display::MAX_LEADERBOARD_ENTRIES];
+bool ApiClient::hasCachedLeaderboard = false;
+unsigned long ApiClient::notModifiedResponses = 0;
+unsigned long ApiClient::identicalResponses = 0;
+unsigned long ApiClient::unparsedResponses = 0;
+char ApiClient::leaderboardBody[Parsing::LEADERBOARD_BODY_LENGTH];
+FixedString<Parsing::URL_LENGTH> ApiClient::requestUrl;
+FixedString<Parsing::CONTENT_TYPE_LENGTH> ApiClient::responseType;
+bool ApiClient::chunkedResponse = false;
+unsigned long ApiClient::notModifiedBytes = 0;
+unsigned long ApiClient::identicalBytes = 0;
+unsigned long ApiClient::updatedBytes = 0;
+bool ApiClient::acceptMsgPack = true;
+bool ApiClient::sendMsgPack = false;
+unsigned long ApiClient::jsonResponses = 0;
+unsigned long ApiClient::msgPackResponses = 0;
+unsigned long ApiClient::jsonBytes = 0;
+unsigned long ApiClient::msgPackBytes = 0;
+unsigned long ApiClient::formatFallbacks = 0;
+unsigned long ApiClient::errorCounts[API_ERROR_COUNT];
+
+bool ScanJournal::mounted = false;
+File ScanJournal::drainFile;
+uint32_t ScanJournal::headOffset = 0;
+uint32_t ScanJournal::committedHead = 0;
+uint32_t ScanJournal::fileSize = 0;
+volatile uint32_t ScanJournal::pendingRecords = 0;
+unsigned long ScanJournal::appendedRecords = 0;
+unsigned long ScanJournal::sentRecords = 0;
+unsigned long ScanJournal::droppedRecords = 0;
+unsigned long ScanJournal::corruptRecords = 0;
+unsigned long ScanJournal::flashBytesWritten = 0;
+unsigned long ScanJournal::drainMillis = 0;
+unsigned long ScanJournal::drainStartedAt = 0;
+
+HTTPClient LeaderboardStream::http;
+WiFiClient LeaderboardStream::client;
+HttpBodyStream LeaderboardStream::body(LeaderboardStream::client, 0, false);
+volatile bool LeaderboardStream::connected = false;
+unsigned long LeaderboardStream::nextAttempt = 0;
+unsigned long LeaderboardStream::retryMs = Timing::STREAM_RETRY_MS;
+bool LeaderboardStream::unsupported = false;
+unsigned long LeaderboardStream::lastActivity = 0;
+FixedString<Parsing::URL_LENGTH> LeaderboardStream::url;
+FixedString<Parsing::STREAM_EVENT_LENGTH> LeaderboardStream::eventName;
+FixedString<Parsing::STREAM_DATA_LENGTH> LeaderboardStream::line;
+FixedString<Parsing::STREAM_DATA_LENGTH> LeaderboardStream::data;
+LeaderboardEntry LeaderboardStream::entries[Display::MAX_LEADERBOARD_ENTRIES];
+unsigned long LeaderboardStream::connects = 0;
+unsigned long LeaderboardStream::drops = 0;
+unsigned long LeaderboardStream::events = 0;
+unsigned long LeaderboardStream::changedRows = 0;
+
+unsigned long DashboardPoller::intervalMs = Timing::DASHBOARD_UPDATE_INTERVAL_MS;
+bool DashboardPoller::hasBaseline = false;
+bool DashboardPoller::hasData = false;
+unsigned long DashboardPoller::lastPollAt = 0;
+unsigned long DashboardPoller::averageGapMs = 0;
+unsigned long DashboardPoller::lastFreshAt = 0;
+unsigned long DashboardPoller::polls = 0;
+unsigned long DashboardPoller::changedResults = 0;
+unsigned long DashboardPoller::failedResults = 0;
+
+SpscRing<NetworkWorker::Job, Tasks::JOB_QUEUE_LENGTH> NetworkWorker::jobs;
+SpscRing<NetworkWorker::Completion, Tasks::RESULT_QUEUE_LENGTH> NetworkWorker::results;
+TaskHandle_t NetworkWorker::taskHandle = nullptr;
+ScanResult NetworkWorker::scanSlots[NetworkWorker::RESULT_SLOTS];
+LeaderboardEntry NetworkWorker::leaderboardSlots[NetworkWorker::RESULT_SLOTS][Display::MAX_LEADERBOARD_ENTRIES];
+int NetworkWorker::nextSlot = 0;
+volatile bool NetworkWorker::jobInFlight = false;
+volatile uint32_t NetworkWorker::wokeAt = 0;
+bool NetworkWorker::streamUpdatePending = false;
+unsigned long NetworkWorker::droppedJobs = 0;
+unsigned long NetworkWorker::handoffStalls = 0;
+int NetworkWorker::peakQueueDepth = 0;
+unsigned long NetworkWorker::completedJobs = 0;
+unsigned long NetworkWorker::lastLatencyMs = 0;
+unsigned long NetworkWorker::maxLatencyMs = 0;
+unsigned long NetworkWorker::totalLatencyMs = 0;
+
+Scheduler::Timer Scheduler::timers[Scheduler::TIMER_COUNT];
+uint8_t Scheduler::queue[Scheduler::TIMER_COUNT];
+int Scheduler::queued = 0;
+TaskHandle_t Scheduler::loopTask = nullptr;
+unsigned long Scheduler::firedTimers = 0;
+unsigned long Scheduler::missedDeadlines = 0;
+unsigned long Scheduler::lastJitterMicros = 0;
+unsigned long Scheduler::maxJitterMicros = 0;
+uint64_t Scheduler::totalJitterMicros = 0;
+unsigned long Scheduler::wakeups = 0;
+uint64_t Scheduler::sleptMicros = 0;
+unsigned long Scheduler::startedAt = 0;
+
+esp_pm_lock_handle_t PowerManager::noSleepLock = nullptr;
+esp_pm_lock_handle_t PowerManager::cpuMaxLock = nullptr;
+esp_err_t PowerManager::configureResult = ESP_OK;
+bool PowerManager::configuredSleep = false;
+bool PowerManager::lockHeld = false;
+bool PowerManager::cpuHeld = false;
+bool PowerManager::radioAwake = false;
+bool PowerManager::rfidIdle = false;
+unsigned long PowerManager::lastBusyAt = 0;
+unsigned long PowerManager::sleeps = 0;
+unsigned long PowerManager::gpioWakeups = 0;
+unsigned long PowerManager::timerWakeups = 0;
+unsigned long PowerManager::uartWakeups = 0;
+uint64_t PowerManager::lightSleptMicros = 0;
+unsigned long PowerManager::startedAt = 0;
+
+char ConfigConsole::input[Provisioning::CONSOLE_LINE_LENGTH + 1];
+size_t ConfigConsole::inputLength = 0;
+bool ConfigConsole::overflow = false;
+bool ConfigConsole::awake = false;
+unsigned long ConfigConsole::lastInputAt = 0;
+unsigned long ConfigConsole::commands = 0;
+
+unsigned long BootTrace::phaseMillis[BootTrace::PHASE_COUNT];
+
+TaskHandle_t CoreLoad::idleTasks[CoreLoad::CORE_COUNT];
+TaskHandle_t CoreLoad::pipelineTasks[CoreLoad::CORE_COUNT];
+const char* CoreLoad::pipelineNames[CoreLoad::CORE_COUNT];
+volatile uint32_t CoreLoad::ticks[CoreLoad::CORE_COUNT];
+volatile uint32_t CoreLoad::idleTicks[CoreLoad::CORE_COUNT];
+volatile uint32_t CoreLoad::pipelineTicks[CoreLoad::CORE_COUNT];
+
+LatencyStats::Histogram LatencyStats::histograms[LatencyStats::STAGE_COUNT];
+uint32_t LatencyStats::cyclesPerMicro = 240;
+uint32_t LatencyStats::overheadCycles = 0;
+bool LatencyStats::enabled = true;
+
+#ifdef ELEVATE_WIRE_BENCHMARK
+uint8_t WireBenchmark::buffer[WireBenchmark::BUFFER_SIZE];
+#endif
 
 // ============================================================================
 // Arduino setup() та loop()
 // ============================================================================
 void setup() {
     Serial.begin(115200);
-    delay(100);
+    BootTrace::mark(BootTrace::SERIAL_PHASE);
     
+#ifdef ELEVATE_WIRE_BENCHMARK
+    WireBenchmark::run();
+#endif
+    
+    Scheduler::begin();
+    CoreLoad::begin();
+    CoreLoad::attach("ui");
+    LatencyStats::calibrate();
     LedDisplay::initializeStats();
-    LedDisplay::showLoadingStep("Initializing...", 10);
-    delay(200);
     
-    LedDisplay::showLoadingStep("Configuring...", 20);
+    // Налаштування — один блоб NVS без розбору; час читання в [status] config.load
     ConfigManager::initialize();
-    delay(200);
+    BootTrace::mark(BootTrace::CONFIG_PHASE);
     
-    LedDisplay::showLoadingStep("Display...", 40);
-    SPI.begin();
-    display.begin();
-    display.setRotation(1);
-    LedDisplay::setDisplayInitialized(true);
-    delay(200);
+    // Wi-Fi, журнал у мережевій задачі та дисплей піднімаються одночасно;
+    // скани приймаються одразу і чекають у журналі, доки не з'явиться мережа
+    WiFiManager::begin();
+    BootTrace::mark(BootTrace::WIFI_START_PHASE);
+    
+    NetworkWorker::start();
+    BootTrace::mark(BootTrace::WORKER_PHASE);
     
-    LedDisplay::showLoadingStep("Buttons...", 50);
+    SPI.begin();
     BadgeReader::initialize();
     LeaderboardButton::initialize();
-    delay(200);
-    
-    LedDisplay::showLoadingStep("Wi-Fi...", 80);
-    WiFi.begin(ConfigManager::WIFI_SSID, ConfigManager::WIFI_PASSWORD);
+    BootTrace::mark(BootTrace::INPUT_PHASE);
     
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < Timing::WIFI_MAX_ATTEMPTS) {
-        delay(Timing::WIFI_CONNECT_DELAY_MS);
-        attempts++;
-        
-        int progress = 80 + (attempts * 15 / Timing::WIFI_MAX_ATTEMPTS);
-        if (progress > 95) progress = 95;
-        LedDisplay::showLoadingStep("Wi-Fi...", progress);
-    }
+    display.begin();
+    display.setRotation(1);
+    RetainedScreen::invalidate();
+    LedDisplay::setDisplayInitialized(true);
+#ifdef ELEVATE_RENDER_BENCHMARK
+    RenderBenchmark::run();
+#endif
+#ifndef ELEVATE_CANVAS_RENDER
+    RetainedScreen::setGlyphAtlas(true);
+#endif
+    BootTrace::mark(BootTrace::DISPLAY_PHASE);
     
-    if (WiFi.status() == WL_CONNECTED) {
-        WiFiManager::setConnectionStatus(true);
-        LedDisplay::showLoadingStep("Ready!", 100);
-        delay(500);
-    } else {
-        WiFiManager::setConnectionStatus(false);
-        LedDisplay::showLoadingStep("Wi-Fi error", 100);
-        delay(1000);
+    Scheduler::every(Scheduler::WIFI_TIMER, Timing::WIFI_RETRY_INTERVAL_MS, WiFiManager::service);
+    Scheduler::every(Scheduler::STATUS_TIMER, Timing::STATUS_REPORT_INTERVAL_MS, StatusReport::print);
+    if (RfidReader::isPresent()) {
+        Scheduler::every(Scheduler::RFID_TIMER, Timing::RFID_ACTIVATE_INTERVAL_MS, BadgeReader::service);
     }
+    CoreLogic::start();
+    ConfigConsole::begin();
+    PowerManager::begin();
+    BootTrace::mark(BootTrace::READY_PHASE);
     
-    LedDisplay::showSystemStatus();
-    delay(5000);
-    
-    if (ConfigManager::currentMode == ConfigManager::SCAN_MODE) {
-        LedDisplay::showWaitingMessage();
-    } else {
-        LedDisplay::showOfflineInfo();
-    }
+#ifdef ELEVATE_NATIVE
+    // Підсумковий звіт прогону на хості
+    NativeHal::onExit(StatusReport::print);
+#endif
 }
 
+// Між подіями loop() спить до найближчого дедлайну, а чип тим часом —
+// у light sleep, якщо PowerManager його не тримає
 void loop() {
-    if (!WiFiManager::isConnected()) {
-        static unsigned long lastCheck = 0;
-        unsigned long now = millis();
-        if (now - lastCheck > Timing::WIFI_CHECK_INTERVAL_MS) {
-            WiFiManager::connect();
-            lastCheck = now;
-        }
-    }
-    
+    ConfigConsole::service();
     CoreLogic::run();
-    delay(Timing::LOOP_DELAY_MS);
+    Scheduler::runDue();
+    PowerManager::idle();
 }
@@ -6,24 +6,338 @@
 #include "types.h"
 #include "modules/config_manager.h"
 #include "modules/wifi_manager.h"
+#include "modules/http_body_stream.h"
+#include "modules/json_pool.h"
+#include "modules/badge_directory.h"
+#include "modules/latency_stats.h"
 
 // ============================================================================
 // ApiClient - HTTP клієнт
 // ============================================================================
 class ApiClient {
+public:
+    enum LeaderboardStatus { LEADERBOARD_FAILED, LEADERBOARD_UPDATED, LEADERBOARD_UNCHANGED };
+    
 private:
     static HTTPClient http;
+    static WiFiClient client;
+    static unsigned long reusedConnections;
+    static unsigned long newConnections;
+    static unsigned long staleReconnects;
+    static JsonPool parsePool;
+    static unsigned long lastParseMicros;
+    static unsigned long maxParseMicros;
+    static unsigned long lastBodyBytes;
+    static uint32_t lastBodyHash;
+    static FixedString<Parsing::ETAG_LENGTH> leaderboardEtag;
+    static uint32_t leaderboardHash;
+    static unsigned long leaderboardBytes;
+    static LeaderboardEntry cachedLeaderboard[Display::MAX_LEADERBOARD_ENTRIES];
+    static bool hasCachedLeaderboard;
+    static unsigned long notModifiedResponses;
+    static unsigned long identicalResponses;
+    static unsigned long unparsedResponses;
+    static char leaderboardBody[Parsing::LEADERBOARD_BODY_LENGTH];
+    static FixedString<Parsing::URL_LENGTH> requestUrl;
+    static FixedString<Parsing::CONTENT_TYPE_LENGTH> responseType;
+    static bool chunkedResponse;
+    // Байти тіла лідерборду за результатом: 304 не передає тіло (рахується
+    // розмір останньої таблиці), однакове й нове тіло прийняті повністю
+    static unsigned long notModifiedBytes;
+    static unsigned long identicalBytes;
+    static unsigned long updatedBytes;
+    static bool acceptMsgPack;
+    static bool sendMsgPack;
+    static unsigned long jsonResponses;
+    static unsigned long msgPackResponses;
+    static unsigned long jsonBytes;
+    static unsigned long msgPackBytes;
+    static unsigned long formatFallbacks;
+    static unsigned long errorCounts[API_ERROR_COUNT];
+    
+    // Тіло запиту збирається в буфер на стеку замість String
+    struct RequestBody {
+        uint8_t data[Parsing::REQUEST_BODY_LENGTH];
+        size_t length;
+        bool msgPack;
+    };
+    
+    // Адреси збираються в requestUrl: запити йдуть по одному з мережевої задачі
+    static const char* buildScanUrl() {
+        requestUrl.format("%s/api/iot/scan", ConfigManager::API_BASE_URL);
+        return requestUrl.c_str();
+    }
+    
+    static void buildScanBody(int userId, RequestBody& body) {
+        parsePool.reset();
+        JsonDocument doc(&parsePool);
+        doc["deviceKey"] = ConfigManager::DEVICE_KEY;
+        doc["userId"] = userId;
+        
+        body.msgPack = sendMsgPack;
+        body.length = body.msgPack ? serializeMsgPack(doc, body.data, sizeof(body.data))
+                                   : serializeJson(doc, body.data, sizeof(body.data));
+    }
+    
+    // Код відповіді чи транспорту -> клас помилки; 0 — перенаправлення
+    // не вдалося (див. postScan)
+    static ApiError classify(int httpCode) {
+        if (httpCode == HTTP_CODE_OK) return API_OK;
+        if (httpCode == 0) return API_REDIRECT_FAILED;
+        if (httpCode == HTTPC_ERROR_CONNECTION_REFUSED) return API_CONNECTION_REFUSED;
+        if (httpCode == HTTPC_ERROR_CONNECTION_LOST) return API_CONNECTION_LOST;
+        if (httpCode == HTTPC_ERROR_READ_TIMEOUT) return API_TIMEOUT;
+        if (httpCode < 0) return API_TRANSPORT_ERROR;
+        if (httpCode >= 500) return API_SERVER_ERROR;
+        if (httpCode >= 400) return API_REJECTED;
+        return API_UNEXPECTED_STATUS;
+    }
+    
+    static void fail(ScanResult& result, ApiError error, int httpCode = 0) {
+        result.error = error;
+        result.httpCode = (int16_t)httpCode;
+        errorCounts[error]++;
+    }
     
-    static String buildScanUrl() {
-        return String(ConfigManager::API_BASE_URL) + "/api/iot/scan";
+    static const char* buildLeaderboardUrl() {
+        requestUrl.format("%s/api/iot/leaderboard?deviceKey=%s",
+                          ConfigManager::API_BASE_URL, ConfigManager::DEVICE_KEY);
+        return requestUrl.c_str();
     }
     
-    static String buildLeaderboardUrl() {
-        return String(ConfigManager::API_BASE_URL) + "/api/iot/leaderboard?deviceKey=" + 
-               String(ConfigManager::DEVICE_KEY);
+    static const char* buildCardUrl(uint64_t cardKey) {
+        UidText uid;
+        BadgeDirectory::formatUid(cardKey, uid);
+        requestUrl.format("%s/api/iot/cards/%s?deviceKey=%s",
+                          ConfigManager::API_BASE_URL, uid.c_str(), ConfigManager::DEVICE_KEY);
+        return requestUrl.c_str();
     }
     
-    static bool handleRedirect(int& httpCode, const String& requestBody = "") {
+    // MessagePack запитується завжди, а JSON лишається запасним варіантом.
+    // Тіла запитів ідуть у MessagePack лише після того, як сервер сам
+    // відповів у цьому форматі
+    static void prepareRequest() {
+        http.setTimeout(Timing::HTTP_TIMEOUT_MS);
+        http.addHeader("Accept", acceptMsgPack ? "application/msgpack, application/json;q=0.5"
+                                               : "application/json");
+        
+        static const char* headerKeys[] = { "Location", "Transfer-Encoding", "ETag", "Content-Type" };
+        http.collectHeaders(headerKeys, 4);
+    }
+    
+    // Сокет відкривається тут, а не всередині HTTPClient, щоб окремо
+    // виміряти DNS і TCP-рукостискання; HTTPClient підхопить готове з'єднання.
+    // WiFiClient без TLS, тож https:// відхиляється, як і в ConfigConsole
+    static bool openConnection() {
+        if (strncmp(ConfigManager::API_BASE_URL, "https://", 8) == 0) return false;
+        
+        const char* host = strstr(ConfigManager::API_BASE_URL, "://");
+        host = host != nullptr ? host + 3 : ConfigManager::API_BASE_URL;
+        
+        size_t hostLength = strcspn(host, ":/");
+        FixedString<Parsing::HOST_LENGTH> hostName;
+        hostName.assign(host, hostLength);
+        uint16_t port = host[hostLength] == ':' ? atoi(host + hostLength + 1) : 80;
+        
+        uint32_t start = LatencyStats::now();
+        if (!client.connect(hostName.c_str(), port)) return false;
+        LatencyStats::record(LatencyStats::CONNECT_STAGE, start);
+        return true;
+    }
+    
+    // Один сокет до API_BASE_URL живе між запитами (keep-alive),
+    // тому TCP-рукостискання відбувається лише коли сервер закрив з'єднання.
+    // Якщо з'єднатися не вдалося, запит не надсилається: інакше HTTPClient
+    // сам повторив би з'єднання й удруге чекав тайм-аут
+    static bool beginRequest(const char* url, bool& reused) {
+        reused = client.connected();
+        if (reused) {
+            reusedConnections++;
+        } else {
+            client.stop();
+            newConnections++;
+            if (!openConnection()) return false;
+        }
+        
+        http.setReuse(true);
+        http.begin(client, url);
+        prepareRequest();
+        return true;
+    }
+    
+    static bool isStaleConnectionError(int httpCode) {
+        return httpCode == HTTPC_ERROR_SEND_HEADER_FAILED ||
+               httpCode == HTTPC_ERROR_SEND_PAYLOAD_FAILED ||
+               httpCode == HTTPC_ERROR_NOT_CONNECTED ||
+               httpCode == HTTPC_ERROR_CONNECTION_LOST;
+    }
+    
+    static int performRequest(const RequestBody* body, const char* etag) {
+        if (etag != nullptr && etag[0] != '\0') {
+            http.addHeader("If-None-Match", etag);
+        }
+        if (body != nullptr) {
+            http.addHeader("Content-Type", body->msgPack ? "application/msgpack" : "application/json");
+        }
+        
+        uint32_t start = LatencyStats::now();
+        int httpCode = body != nullptr ? http.POST(const_cast<uint8_t*>(body->data), body->length)
+                                       : http.GET();
+        LatencyStats::record(LatencyStats::TTFB_STAGE, start);
+        
+        // header() щоразу повертає копію String, тож заголовки, потрібні
+        // розбору, читаються раз на відповідь
+        responseType.clear();
+        chunkedResponse = false;
+        if (httpCode > 0) {
+            responseType = http.header("Content-Type").c_str();
+            chunkedResponse = http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+        }
+        return httpCode;
+    }
+    
+    // Відповідь, яку не розбиратимемо, дочитується, щоб сокет лишився чистим
+    static void discardResponse() {
+        HttpBodyStream body(http.getStream(), http.getSize(), isChunkedResponse());
+        body.drain();
+        http.end();
+    }
+    
+    static int sendRequest(const char* url, const RequestBody* body = nullptr, const char* etag = nullptr) {
+        bool reused;
+        if (!beginRequest(url, reused)) return HTTPC_ERROR_CONNECTION_REFUSED;
+        int httpCode = performRequest(body, etag);
+        
+        // Сервер міг закрити простоюючий сокет — повторюємо один раз на новому
+        if (reused && isStaleConnectionError(httpCode)) {
+            http.end();
+            client.stop();
+            staleReconnects++;
+            
+            if (!beginRequest(url, reused)) return HTTPC_ERROR_CONNECTION_REFUSED;
+            httpCode = performRequest(body, etag);
+        }
+        
+        // Сервер не вміє віддавати MessagePack — далі лише JSON
+        if (httpCode == HTTP_CODE_NOT_ACCEPTABLE && acceptMsgPack) {
+            discardResponse();
+            acceptMsgPack = false;
+            formatFallbacks++;
+            
+            if (!beginRequest(url, reused)) return HTTPC_ERROR_CONNECTION_REFUSED;
+            httpCode = performRequest(body, etag);
+        }
+        
+        return httpCode;
+    }
+    
+    static bool isMsgPackResponse() {
+        return strstr(responseType.c_str(), "msgpack") != nullptr;
+    }
+    
+    static bool isChunkedResponse() { return chunkedResponse; }
+    
+    // Фільтри залишають у документі лише ті поля, які потрібні екрану
+    static JsonDocument& scanFilter() {
+        static JsonDocument filter;
+        if (filter.isNull()) {
+            filter["userId"] = true;
+            filter["teamId"] = true;
+            filter["fullName"] = true;
+            filter["teamPoints"] = true;
+            filter["teamLevelName"] = true;
+            filter["recentBadges"][0] = true;
+        }
+        return filter;
+    }
+    
+    static JsonDocument& leaderboardFilter() {
+        static JsonDocument filter;
+        if (filter.isNull()) {
+            filter[0]["rank"] = true;
+            filter[0]["userId"] = true;
+            filter[0]["fullName"] = true;
+            filter[0]["teamPoints"] = true;
+            filter[0]["teamLevel"] = true;
+        }
+        return filter;
+    }
+    
+    static JsonDocument& cardFilter() {
+        static JsonDocument filter;
+        if (filter.isNull()) {
+            filter["userId"] = true;
+        }
+        return filter;
+    }
+    
+    static void readLeaderboardEntry(JsonObject entry, int index, LeaderboardEntry& target) {
+        target.rank = entry["rank"] | (index + 1);
+        target.userId = entry["userId"] | 0;
+        target.fullName = entry["fullName"] | "";
+        target.teamPoints = entry["teamPoints"] | 0;
+        target.teamLevel = entry["teamLevel"] | "";
+    }
+    
+    static bool applyLeaderboardEntry(JsonObject entry, int index, LeaderboardEntry& target) {
+        LeaderboardEntry updated;
+        readLeaderboardEntry(entry, index, updated);
+        if (updated.rank == target.rank && updated.userId == target.userId &&
+            updated.teamPoints == target.teamPoints &&
+            updated.fullName == target.fullName.c_str() &&
+            updated.teamLevel == target.teamLevel.c_str()) {
+            return false;
+        }
+        target = updated;
+        return true;
+    }
+    
+    // Обсяг, хеш і формат уже дочитаного тіла
+    static void countBody(const HttpBodyStream& body, bool msgPack) {
+        lastBodyBytes = body.getBytesRead();
+        lastBodyHash = body.getContentHash();
+        
+        if (msgPack) {
+            msgPackResponses++;
+            msgPackBytes += lastBodyBytes;
+            sendMsgPack = true;
+        } else {
+            jsonResponses++;
+            jsonBytes += lastBodyBytes;
+        }
+    }
+    
+    // Розбір іде прямо з сокета без проміжного String; час включає
+    // очікування байтів від сервера
+    static bool parseResponse(JsonDocument& doc, JsonDocument& filter) {
+        HttpBodyStream body(http.getStream(), http.getSize(), isChunkedResponse());
+        return parseResponse(body, doc, filter);
+    }
+    
+    static bool parseResponse(HttpBodyStream& body, JsonDocument& doc, JsonDocument& filter) {
+        bool msgPack = isMsgPackResponse();
+        uint32_t waitBefore = body.getWaitCycles();
+        
+        unsigned long start = micros();
+        uint32_t startCycles = LatencyStats::now();
+        DeserializationError error = msgPack
+            ? deserializeMsgPack(doc, body, DeserializationOption::Filter(filter))
+            : deserializeJson(doc, body, DeserializationOption::Filter(filter));
+        uint32_t parseCycles = LatencyStats::now() - startCycles;
+        lastParseMicros = micros() - start;
+        
+        // Розбір іде потоком, тож очікування сокета віднімається від розбору
+        LatencyStats::recordCycles(LatencyStats::BODY_STAGE, body.getWaitCycles());
+        LatencyStats::recordCycles(LatencyStats::PARSE_STAGE,
+                                   parseCycles - (body.getWaitCycles() - waitBefore));
+        if (lastParseMicros > maxParseMicros) maxParseMicros = lastParseMicros;
+        
+        body.drain();
+        countBody(body, msgPack);
+        return error == DeserializationError::Ok;
+    }
+    
+    static bool handleRedirect(int& httpCode, const RequestBody* body = nullptr) {
         if (httpCode != 307 && httpCode != 301) return false;
         
         String location = http.header("Location");
@@ -35,57 +349,61 @@ private:
         
         if (location.length() == 0) return false;
         
+        // Адреса перенаправлення може вказувати на інший хост
+        client.stop();
         http.begin(location);
-        http.setTimeout(Timing::HTTP_TIMEOUT_MS);
-        if (requestBody.length() > 0) {
-            http.addHeader("Content-Type", "application/json");
-            httpCode = http.POST(requestBody);
-        } else {
-            httpCode = http.GET();
-        }
+        prepareRequest();
+        httpCode = performRequest(body, nullptr);
         
         return (httpCode != 307 && httpCode != 301);
     }
     
-    static void parseErrorResponse(int httpCode, String& errorMessage) {
-        String response = http.getString();
+    // Повертає 0, якщо перенаправлення не вдалося
+    static int postScan(int userId) {
+        const char* url = buildScanUrl();
+        RequestBody body;
+        buildScanBody(userId, body);
+        int httpCode = sendRequest(url, &body);
         
-        if (response.length() == 0) {
-            if (httpCode == HTTP_CODE_BAD_REQUEST) {
-                errorMessage = "Bad request (400)";
-            } else if (httpCode == HTTP_CODE_UNAUTHORIZED) {
-                errorMessage = "Unauthorized (401)";
-            } else {
-                errorMessage = "Server error: " + String(httpCode);
-            }
-            return;
+        // Сервер не приймає MessagePack — повторюємо той самий запит у JSON
+        if (httpCode == HTTP_CODE_UNSUPPORTED_MEDIA_TYPE && body.msgPack) {
+            discardResponse();
+            sendMsgPack = false;
+            formatFallbacks++;
+            
+            buildScanBody(userId, body);
+            httpCode = sendRequest(url, &body);
         }
         
-        JsonDocument errorDoc;
-        if (deserializeJson(errorDoc, response) == DeserializationError::Ok) {
-            if (errorDoc["message"].is<String>()) {
-                errorMessage = errorDoc["message"].as<String>();
-            } else if (errorDoc["error"].is<String>()) {
-                errorMessage = errorDoc["error"].as<String>();
-            } else if (errorDoc["title"].is<String>()) {
-                errorMessage = errorDoc["title"].as<String>();
-            } else {
-                errorMessage = "Server error: " + String(httpCode);
-            }
-        } else {
-            errorMessage = response.substring(0, min(50, (int)response.length()));
+        if (httpCode == 307 || httpCode == 301) {
+            if (!handleRedirect(httpCode, &body)) return 0;
         }
+        return httpCode;
     }
     
-    static void parseConnectionError(int httpCode, String& errorMessage) {
-        if (httpCode == HTTPC_ERROR_CONNECTION_REFUSED) {
-            errorMessage = "Connection refused";
-        } else if (httpCode == HTTPC_ERROR_CONNECTION_LOST) {
-            errorMessage = "Connection lost";
-        } else if (httpCode == HTTPC_ERROR_READ_TIMEOUT) {
-            errorMessage = "Connection timeout";
+    // З тіла відмови зберігається лише повідомлення сервера: решту
+    // тексту formatError() збере з коду, коли помилку показуватимуть
+    static void readServerMessage(ErrorText& serverMessage) {
+        // Тіло помилки читається в буфер на стеку замість String
+        char response[Parsing::ERROR_BODY_LENGTH + 1];
+        HttpBodyStream body(http.getStream(), http.getSize(), isChunkedResponse());
+        size_t length = body.readInto(response, Parsing::ERROR_BODY_LENGTH);
+        response[length] = '\0';
+        body.drain();
+        if (length == 0) return;
+        
+        parsePool.reset();
+        JsonDocument errorDoc(&parsePool);
+        if (deserializeJson(errorDoc, response, length) == DeserializationError::Ok) {
+            if (errorDoc["message"].is<const char*>()) {
+                serverMessage = errorDoc["message"].as<const char*>();
+            } else if (errorDoc["error"].is<const char*>()) {
+                serverMessage = errorDoc["error"].as<const char*>();
+            } else if (errorDoc["title"].is<const char*>()) {
+                serverMessage = errorDoc["title"].as<const char*>();
+            }
         } else {
-            errorMessage = "Server unavailable (error: " + String(httpCode) + ")";
+            serverMessage.assign(response, 50);
         }
     }
     
@@ -94,106 +412,323 @@ public:
         ScanResult result;
         
         if (!WiFiManager::ensureConnection()) {
-            result.errorMessage = "No network";
+            fail(result, API_NO_NETWORK);
             return result;
         }
         
-        String url = buildScanUrl();
-        JsonDocument doc;
-        doc["deviceKey"] = ConfigManager::DEVICE_KEY;
-        doc["userId"] = userId;
-        
-        String requestBody;
-        serializeJson(doc, requestBody);
-        
-        http.begin(url);
-        http.setTimeout(Timing::HTTP_TIMEOUT_MS);
-        http.addHeader("Content-Type", "application/json");
+        int httpCode = postScan(userId);
+        ApiError error = classify(httpCode);
         
-        int httpCode = http.POST(requestBody);
-        
-        if (httpCode == 307 || httpCode == 301) {
-            if (!handleRedirect(httpCode, requestBody)) {
-                result.errorMessage = "Redirect error";
-                http.end();
-                return result;
-            }
-        }
-        
-        if (httpCode == HTTP_CODE_OK) {
-            String response = http.getString();
-            JsonDocument responseDoc;
+        if (error == API_OK) {
+            parsePool.reset();
+            JsonDocument responseDoc(&parsePool);
             
-            if (deserializeJson(responseDoc, response) == DeserializationError::Ok) {
+            if (parseResponse(responseDoc, scanFilter())) {
                 result.success = true;
                 result.userId = responseDoc["userId"] | 0;
                 result.teamId = responseDoc["teamId"] | 0;
-                result.fullName = responseDoc["fullName"].as<String>();
+                result.fullName = responseDoc["fullName"] | "";
                 result.teamPoints = responseDoc["teamPoints"] | 0;
-                result.teamLevelName = responseDoc["teamLevelName"].as<String>();
+                result.teamLevelName = responseDoc["teamLevelName"] | "";
                 
                 JsonArray badges = responseDoc["recentBadges"].as<JsonArray>();
                 result.badgeCount = min((int)badges.size(), Display::MAX_RECENT_BADGES);
                 for (int i = 0; i < result.badgeCount; i++) {
-                    result.recentBadges[i] = badges[i].as<String>();
+                    result.recentBadges[i] = badges[i] | "";
                 }
             } else {
-                result.errorMessage = "Response parsing error";
+                fail(result, API_BAD_RESPONSE, httpCode);
             }
-        } else if (httpCode >= 400) {
-            parseErrorResponse(httpCode, result.errorMessage);
-        } else if (httpCode < 0) {
-            parseConnectionError(httpCode, result.errorMessage);
         } else {
-            result.errorMessage = "Server error: " + String(httpCode);
+            if (error == API_REJECTED) readServerMessage(result.serverMessage);
+            fail(result, error, httpCode);
         }
         
         http.end();
         return result;
     }
     
-    static bool getLeaderboard(LeaderboardEntry* entries, int maxEntries) {
-        if (!WiFiManager::ensureConnection()) {
+    // Текст помилки для екрана; викликається лише при показі
+    static void formatError(const ScanResult& result, ErrorText& text) {
+        switch (result.error) {
+            case API_OK:
+                text = "";
+                break;
+            case API_NO_NETWORK:
+                text = "No network";
+                break;
+            case API_CONNECTION_REFUSED:
+                text = "Connection refused";
+                break;
+            case API_CONNECTION_LOST:
+                text = "Connection lost";
+                break;
+            case API_TIMEOUT:
+                text = "Connection timeout";
+                break;
+            case API_TRANSPORT_ERROR:
+                text.format("Server unavailable (error: %d)", result.httpCode);
+                break;
+            case API_REJECTED:
+                if (!result.serverMessage.isEmpty()) {
+                    text = result.serverMessage.c_str();
+                } else if (result.httpCode == HTTP_CODE_BAD_REQUEST) {
+                    text = "Bad request (400)";
+                } else if (result.httpCode == HTTP_CODE_UNAUTHORIZED) {
+                    text = "Unauthorized (401)";
+                } else {
+                    text.format("Server error: %d", result.httpCode);
+                }
+                break;
+            case API_REDIRECT_FAILED:
+                text = "Redirect error";
+                break;
+            case API_BAD_RESPONSE:
+                text = "Response parsing error";
+                break;
+            default:
+                text.format("Server error: %d", result.httpCode);
+                break;
+        }
+    }
+    
+    // Повторна відправка сканування з журналу: відповідь не потрібна.
+    // Повертає false, якщо запис треба лишити в журналі; відхилені
+    // сервером (4xx) записи вважаються обробленими
+    static bool replayScan(int userId) {
+        if (!WiFiManager::isConnected()) {
             return false;
         }
         
-        String url = buildLeaderboardUrl();
-        http.begin(url);
-        http.setTimeout(Timing::HTTP_TIMEOUT_MS);
+        int httpCode = postScan(userId);
+        if (httpCode == 0) {
+            http.end();
+            return false;
+        }
         
-        int httpCode = http.GET();
+        if (httpCode > 0) {
+            HttpBodyStream body(http.getStream(), http.getSize(), isChunkedResponse());
+            body.drain();
+        }
+        
+        http.end();
+        
+        return !isRetryableError(classify(httpCode));
+    }
+    
+    // Останні записи та валідатор зберігаються: на 304 тіло не передається,
+    // а тіло з тим самим хешем не розбирається, записи не копіюються й
+    // екран не оновлюється
+    static LeaderboardStatus getLeaderboard(LeaderboardEntry* entries, int maxEntries) {
+        if (!WiFiManager::ensureConnection()) {
+            return LEADERBOARD_FAILED;
+        }
+        
+        const char* url = buildLeaderboardUrl();
+        const char* etag = hasCachedLeaderboard ? leaderboardEtag.c_str() : nullptr;
+        int httpCode = sendRequest(url, nullptr, etag);
         
         if (httpCode == 307 || httpCode == 301) {
             if (!handleRedirect(httpCode)) {
                 http.end();
-                return false;
+                return LEADERBOARD_FAILED;
             }
         }
         
-        if (httpCode == HTTP_CODE_OK) {
-            String response = http.getString();
-            JsonDocument doc;
+        LeaderboardStatus status = LEADERBOARD_FAILED;
+        int count = min(maxEntries, (int)Display::MAX_LEADERBOARD_ENTRIES);
+        
+        if (httpCode == HTTP_CODE_NOT_MODIFIED && hasCachedLeaderboard) {
+            notModifiedResponses++;
+            notModifiedBytes += leaderboardBytes;
+            status = LEADERBOARD_UNCHANGED;
+        } else if (httpCode == HTTP_CODE_OK) {
+            // Тіло спершу читається в буфер, і хеш порівнюється до розбору.
+            // Тіло, що не вмістилось, розбирається потоком далі, а хеш
+            // звіряється вже після розбору
+            HttpBodyStream body(http.getStream(), http.getSize(), isChunkedResponse());
+            bool complete = body.prefetch(leaderboardBody, sizeof(leaderboardBody));
+            bool parsed = false;
+            bool unchanged = complete && hasCachedLeaderboard && body.getContentHash() == leaderboardHash;
             
-            if (deserializeJson(doc, response) == DeserializationError::Ok) {
-                JsonArray leaderboard = doc.as<JsonArray>();
-                int count = min((int)leaderboard.size(), maxEntries);
+            if (unchanged) {
+                LatencyStats::recordCycles(LatencyStats::BODY_STAGE, body.getWaitCycles());
+                countBody(body, isMsgPackResponse());
+                unparsedResponses++;
+            } else {
+                parsePool.reset();
+                JsonDocument doc(&parsePool);
+                parsed = parseResponse(body, doc, leaderboardFilter());
+                unchanged = parsed && hasCachedLeaderboard && lastBodyHash == leaderboardHash;
                 
-                for (int i = 0; i < count; i++) {
-                    JsonObject entry = leaderboard[i];
-                    entries[i].rank = entry["rank"] | (i + 1);
-                    entries[i].userId = entry["userId"] | 0;
-                    entries[i].fullName = entry["fullName"].as<String>();
-                    entries[i].teamPoints = entry["teamPoints"] | 0;
-                    entries[i].teamLevel = entry["teamLevel"].as<String>();
+                if (parsed && !unchanged) {
+                    JsonArray leaderboard = doc.as<JsonArray>();
+                    int received = min((int)leaderboard.size(), count);
+                    
+                    for (int i = 0; i < count; i++) {
+                        cachedLeaderboard[i] = LeaderboardEntry();
+                    }
+                    for (int i = 0; i < received; i++) {
+                        readLeaderboardEntry(leaderboard[i], i, cachedLeaderboard[i]);
+                    }
+                    
+                    hasCachedLeaderboard = true;
+                    leaderboardHash = lastBodyHash;
+                    leaderboardBytes = lastBodyBytes;
+                    updatedBytes += lastBodyBytes;
+                    status = LEADERBOARD_UPDATED;
                 }
-                
+            }
+            
+            if (unchanged) {
+                identicalResponses++;
+                identicalBytes += lastBodyBytes;
+                status = LEADERBOARD_UNCHANGED;
+            }
+            if (unchanged || parsed) leaderboardEtag = http.header("ETag").c_str();
+        }
+        
+        if (status != LEADERBOARD_FAILED) {
+            for (int i = 0; i < count; i++) {
+                entries[i] = cachedLeaderboard[i];
+            }
+        }
+        
+        http.end();
+        return status;
+    }
+    
+    // Доступність API для екрана стану: будь-яка змістовна відповідь
+    // сервера, навіть відмова через ключ пристрою
+    static bool probeApi() {
+        if (!WiFiManager::ensureConnection()) return false;
+        
+        int httpCode = sendRequest(buildLeaderboardUrl());
+        if (httpCode > 0) {
+            discardResponse();
+        } else {
+            http.end();
+        }
+        
+        return httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_BAD_REQUEST ||
+               httpCode == HTTP_CODE_UNAUTHORIZED;
+    }
+    
+    // Повертає false лише при мережевій помилці; на 404 userId стає
+    // BadgeDirectory::UNKNOWN_CARD, щоб картку більше не перевіряти
+    static bool lookupCard(uint64_t cardKey, int& userId) {
+        userId = 0;
+        if (!WiFiManager::ensureConnection()) {
+            return false;
+        }
+        
+        const char* url = buildCardUrl(cardKey);
+        int httpCode = sendRequest(url);
+        
+        if (httpCode == 307 || httpCode == 301) {
+            if (!handleRedirect(httpCode)) {
                 http.end();
-                return true;
+                return false;
             }
         }
         
+        bool resolved = false;
+        if (httpCode == HTTP_CODE_OK) {
+            parsePool.reset();
+            JsonDocument doc(&parsePool);
+            
+            if (parseResponse(doc, cardFilter())) {
+                userId = doc["userId"] | 0;
+                if (userId <= 0) userId = BadgeDirectory::UNKNOWN_CARD;
+                resolved = true;
+            }
+        } else if (httpCode == HTTP_CODE_NOT_FOUND) {
+            HttpBodyStream body(http.getStream(), http.getSize(), isChunkedResponse());
+            body.drain();
+            userId = BadgeDirectory::UNKNOWN_CARD;
+            resolved = true;
+        }
+        
         http.end();
-        return false;
+        return resolved;
+    }
+    
+    // Подія потоку лідерборду: об'єкт оновлює рядок за його rank,
+    // масив замінює всю таблицю. Повертає кількість змінених рядків
+    static int applyLeaderboardUpdate(const char* json, size_t length,
+                                      LeaderboardEntry* entries, int maxEntries) {
+        parsePool.reset();
+        JsonDocument doc(&parsePool);
+        if (deserializeJson(doc, json, length) != DeserializationError::Ok) {
+            return -1;
+        }
+        
+        int changed = 0;
+        if (doc.is<JsonArray>()) {
+            JsonArray leaderboard = doc.as<JsonArray>();
+            int received = min((int)leaderboard.size(), maxEntries);
+            for (int i = 0; i < maxEntries; i++) {
+                if (i < received) {
+                    if (applyLeaderboardEntry(leaderboard[i], i, entries[i])) changed++;
+                } else if (entries[i].userId != 0) {
+                    entries[i] = LeaderboardEntry();
+                    changed++;
+                }
+            }
+        } else if (doc.is<JsonObject>()) {
+            int index = (doc["rank"] | 0) - 1;
+            if (index >= 0 && index < maxEntries &&
+                applyLeaderboardEntry(doc.as<JsonObject>(), index, entries[index])) {
+                changed++;
+            }
+        }
+        return changed;
+    }
+    
+    // Мережева задача після зміни бекенду: сокет, ETag і таблиця належали
+    // старому серверу, а формат новий сервер узгоджує заново
+    static void resetBackend() {
+        client.stop();
+        leaderboardEtag.clear();
+        leaderboardHash = 0;
+        hasCachedLeaderboard = false;
+        for (int i = 0; i < Display::MAX_LEADERBOARD_ENTRIES; i++) {
+            cachedLeaderboard[i] = LeaderboardEntry();
+        }
+        acceptMsgPack = true;
+        sendMsgPack = false;
+    }
+    
+    static unsigned long getReusedConnections() { return reusedConnections; }
+    static unsigned long getNewConnections() { return newConnections; }
+    static unsigned long getStaleReconnects() { return staleReconnects; }
+    static unsigned long getLastParseMicros() { return lastParseMicros; }
+    static unsigned long getMaxParseMicros() { return maxParseMicros; }
+    static unsigned long getLastBodyBytes() { return lastBodyBytes; }
+    static const char* getAcceptFormat() { return acceptMsgPack ? "msgpack" : "json"; }
+    static const char* getSendFormat() { return sendMsgPack ? "msgpack" : "json"; }
+    static unsigned long getJsonResponses() { return jsonResponses; }
+    static unsigned long getMsgPackResponses() { return msgPackResponses; }
+    static unsigned long getJsonBytes() { return jsonBytes; }
+    static unsigned long getMsgPackBytes() { return msgPackBytes; }
+    static unsigned long getFormatFallbacks() { return formatFallbacks; }
+    static const LeaderboardEntry* getCachedLeaderboard() { return cachedLeaderboard; }
+    static unsigned long getNotModifiedResponses() { return notModifiedResponses; }
+    static unsigned long getIdenticalResponses() { return identicalResponses; }
+    static unsigned long getUnparsedResponses() { return unparsedResponses; }
+    static unsigned long getNotModifiedBytes() { return notModifiedBytes; }
+    static unsigned long getIdenticalBytes() { return identicalBytes; }
+    static unsigned long getUpdatedBytes() { return updatedBytes; }
+    static size_t getParsePoolPeak() { return parsePool.getPeak(); }
+    static size_t getParsePoolCapacity() { return parsePool.getCapacity(); }
+    static unsigned long getErrorCount(ApiError error) { return errorCounts[error]; }
+    
+    static const char* getErrorName(ApiError error) {
+        static const char* names[] = {
+            "ok", "no_net", "refused", "lost", "timeout", "transport",
+            "5xx", "4xx", "redirect", "status", "parse"
+        };
+        return names[error];
     }
 };
 
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "constants.h"
+#include "fixed_string.h"
+#include "badge_table.h"
+
+// ============================================================================
+// BadgeDirectory - Відповідність UID картки -> userId
+// ============================================================================
+typedef FixedString<Badges::UID_HEX_LENGTH> UidText;
+
+class BadgeDirectory {
+public:
+    // Картку перевірено на сервері, але користувача з нею немає
+    static const int UNKNOWN_CARD = -1;
+    
+private:
+    struct CachedCard {
+        uint64_t key;
+        int32_t userId;
+    };
+    
+    static CachedCard cache[Badges::CARD_CACHE_SIZE];
+    static int nextCacheSlot;
+    static unsigned long lookups;
+    static unsigned long tableHits;
+    static unsigned long cacheHits;
+    static unsigned long misses;
+    static unsigned long lastLookupMicros;
+    static unsigned long maxLookupMicros;
+    
+    // Хеш має збігатися з hash_key у tools/gen_badge_table.py
+    static uint64_t hashKey(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDULL;
+        key ^= key >> 33;
+        key *= 0xC4CEB9FE1A85EC53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+    
+    // Лінійне зондування не довше за MAX_PROBE, який порахував генератор,
+    // тож відсутня картка коштує стільки ж, скільки найгірша присутня
+    static int findInTable(uint64_t key) {
+        unsigned int index = hashKey(key) & (BadgeTable::SLOT_COUNT - 1);
+        for (unsigned int probe = 0; probe <= BadgeTable::MAX_PROBE; probe++) {
+            uint64_t slotKey = BadgeTable::KEYS[index];
+            if (slotKey == key) return BadgeTable::USER_IDS[index];
+            if (slotKey == 0) return 0;
+            index = (index + 1) & (BadgeTable::SLOT_COUNT - 1);
+        }
+        return 0;
+    }
+    
+    static int findInCache(uint64_t key) {
+        for (int i = 0; i < Badges::CARD_CACHE_SIZE; i++) {
+            if (cache[i].key == key) return cache[i].userId;
+        }
+        return 0;
+    }
+    
+    static void saveCache() {
+        Preferences prefs;
+        if (prefs.begin("badges", false)) {
+            prefs.putBytes("cache", cache, sizeof(cache));
+            prefs.end();
+        }
+    }
+    
+public:
+    static void initialize() {
+        memset(cache, 0, sizeof(cache));
+        nextCacheSlot = 0;
+        
+        Preferences prefs;
+        if (prefs.begin("badges", true)) {
+            if (prefs.getBytesLength("cache") == sizeof(cache)) {
+                prefs.getBytes("cache", cache, sizeof(cache));
+            }
+            prefs.end();
+        }
+        
+        // Невідомі картки не переживають перезавантаження: користувача
+        // могли додати на сервері
+        for (int i = 0; i < Badges::CARD_CACHE_SIZE; i++) {
+            if (cache[i].userId == UNKNOWN_CARD) cache[i].key = 0;
+            if (cache[i].key != 0) nextCacheSlot = (i + 1) % Badges::CARD_CACHE_SIZE;
+        }
+    }
+    
+    // Ключ: довжина UID у старшому байті, далі до 7 байтів UID.
+    // Повертає 0 для UID, які не вміщаються в ключ
+    static uint64_t makeKey(const uint8_t* uid, uint8_t length) {
+        if (length == 0 || length > Badges::MAX_UID_LENGTH) return 0;
+        
+        uint64_t key = (uint64_t)length << 56;
+        for (uint8_t i = 0; i < length; i++) {
+            key |= (uint64_t)uid[i] << (8 * (6 - i));
+        }
+        return key;
+    }
+    
+    static void formatUid(uint64_t key, UidText& text) {
+        text.clear();
+        uint8_t length = key >> 56;
+        for (uint8_t i = 0; i < length; i++) {
+            char hex[3];
+            snprintf(hex, sizeof(hex), "%02X", (unsigned)((key >> (8 * (6 - i))) & 0xFF));
+            text.append(hex);
+        }
+    }
+    
+    // Повертає userId, UNKNOWN_CARD або 0, якщо картку треба перевірити на сервері
+    static int lookup(uint64_t key) {
+        unsigned long start = micros();
+        lookups++;
+        
+        int userId = findInTable(key);
+        if (userId != 0) {
+            tableHits++;
+        } else {
+            userId = findInCache(key);
+            if (userId != 0) {
+                cacheHits++;
+            } else {
+                misses++;
+            }
+        }
+        
+        lastLookupMicros = micros() - start;
+        if (lastLookupMicros > maxLookupMicros) maxLookupMicros = lastLookupMicros;
+        return userId;
+    }
+    
+    // Відповідь сервера запам'ятовується, щоб картку не перевіряти вдруге.
+    // Знайдені користувачі зберігаються в NVS, невідомі — лише в RAM
+    static void remember(uint64_t key, int userId) {
+        if (key == 0) return;
+        
+        for (int i = 0; i < Badges::CARD_CACHE_SIZE; i++) {
+            if (cache[i].key == key) {
+                cache[i].userId = userId;
+                if (userId > 0) saveCache();
+                return;
+            }
+        }
+        
+        cache[nextCacheSlot].key = key;
+        cache[nextCacheSlot].userId = userId;
+        nextCacheSlot = (nextCacheSlot + 1) % Badges::CARD_CACHE_SIZE;
+        if (userId > 0) saveCache();
+    }
+    
+    static unsigned int getTableCards() { return BadgeTable::CARD_COUNT; }
+    static unsigned int getTableSlots() { return BadgeTable::SLOT_COUNT; }
+    static unsigned int getTableBytes() {
+        return sizeof(BadgeTable::KEYS) + sizeof(BadgeTable::USER_IDS);
+    }
+    static unsigned int getCacheBytes() { return sizeof(cache); }
+    static unsigned long getLookups() { return lookups; }
+    static unsigned long getTableHits() { return tableHits; }
+    static unsigned long getCacheHits() { return cacheHits; }
+    static unsigned long getMisses() { return misses; }
+    static unsigned long getLastLookupMicros() { return lastLookupMicros; }
+    static unsigned long getMaxLookupMicros() { return maxLookupMicros; }
+};
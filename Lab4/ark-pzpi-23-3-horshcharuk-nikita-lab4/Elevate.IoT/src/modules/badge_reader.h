@@ -2,6 +2,9 @@
 
 #include <Arduino.h>
 #include "constants.h"
+#include "modules/input_events.h"
+#include "modules/rfid_reader.h"
+#include "modules/badge_directory.h"
 
 // ============================================================================
 // BadgeReader - Модуль зчитування бейджів
@@ -9,8 +12,8 @@
 class BadgeReader {
 private:
     static bool isInitialized;
-    static unsigned long lastButtonPressTime;
     static int lastReadUserId;
+    static uint64_t unresolvedCardKey;
     
     static const int BUTTON_COUNT = 3;
     
@@ -45,55 +48,63 @@ private:
         }
     }
     
+    static int readCard() {
+        uint64_t cardKey = RfidReader::readCard();
+        if (cardKey == 0) return 0;
+        
+        int userId = BadgeDirectory::lookup(cardKey);
+        if (userId == 0) {
+            unresolvedCardKey = cardKey;
+        } else if (userId > 0) {
+            lastReadUserId = userId;
+        }
+        return userId;
+    }
+    
 public:
     static void initialize() {
         if (isInitialized) return;
         
         for (int i = 0; i < BUTTON_COUNT; i++) {
-            pinMode(getButtonPin(i), INPUT_PULLUP);
+            InputEvents::attach(getButtonPin(i), (InputEvents::Source)(InputEvents::BADGE_BUTTON_1 + i));
         }
         
-        lastButtonPressTime = 0;
+        BadgeDirectory::initialize();
+        RfidReader::initialize();
+        
         lastReadUserId = 0;
+        unresolvedCardKey = 0;
         isInitialized = true;
     }
     
-    static int readUserId() {
-        if (!isInitialized) initialize();
-        
-        unsigned long now = millis();
-        if (now - lastButtonPressTime < Timing::BUTTON_DEBOUNCE_MS) {
-            return 0;
+    static void service() {
+        RfidReader::service();
+    }
+    
+    // Повертає userId, BadgeDirectory::UNKNOWN_CARD для відхиленої сервером
+    // картки або 0, якщо бейджа немає чи картку треба перевірити на сервері
+    static int readUserId(const InputEvent& event) {
+        if (event.source == InputEvents::RFID_CARD) {
+            return readCard();
         }
         
-        for (int i = 0; i < BUTTON_COUNT; i++) {
-            int pin = getButtonPin(i);
-            if (digitalRead(pin) == LOW) {
-                delay(Timing::BUTTON_PRESS_CHECK_DELAY_MS);
-                if (digitalRead(pin) == LOW) {
-                    lastButtonPressTime = now;
-                    int userId = getUserId(i);
-                    lastReadUserId = userId;
-                    
-                    while (digitalRead(pin) == LOW) {
-                        delay(10);
-                    }
-                    
-                    return userId;
-                }
-            }
+        int index = event.source - InputEvents::BADGE_BUTTON_1;
+        if (index < 0 || index >= BUTTON_COUNT) {
+            return 0;
         }
         
-        return 0;
+        lastReadUserId = getUserId(index);
+        return lastReadUserId;
     }
     
-    static bool hasNewScan() {
-        if (!isInitialized) initialize();
-        return readUserId() > 0;
+    static bool takeUnresolvedCard(uint64_t& cardKey) {
+        if (unresolvedCardKey == 0) return false;
+        cardKey = unresolvedCardKey;
+        unresolvedCardKey = 0;
+        return true;
     }
     
     static int getLastUserId() {
         return lastReadUserId;
     }
 };
-
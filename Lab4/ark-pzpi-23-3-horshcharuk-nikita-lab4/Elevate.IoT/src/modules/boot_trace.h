@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ============================================================================
+// BootTrace - Час фаз запуску в Serial
+// ============================================================================
+// Час від скидання чипа, тож перша фаза включає завантажувач:
+//   [boot] phase=wifi t=1840ms
+class BootTrace {
+public:
+    enum Phase : uint8_t {
+        SERIAL_PHASE,
+        CONFIG_PHASE,
+        WIFI_START_PHASE,
+        WORKER_PHASE,
+        INPUT_PHASE,
+        DISPLAY_PHASE,
+        READY_PHASE,
+        WIFI_PHASE,
+        API_PHASE,
+        PHASE_COUNT
+    };
+    
+private:
+    static unsigned long phaseMillis[PHASE_COUNT];
+    
+    static const char* getName(Phase phase) {
+        static const char* names[] = {
+            "serial", "config", "wifi_start", "worker", "input", "display", "ready", "wifi", "api"
+        };
+        return names[phase];
+    }
+    
+public:
+    static void mark(Phase phase) {
+        if (phaseMillis[phase] != 0) return;
+        
+        phaseMillis[phase] = (unsigned long)(esp_timer_get_time() / 1000);
+        Serial.printf("[boot] phase=%s t=%lums\n", getName(phase), phaseMillis[phase]);
+    }
+    
+    // 0, якщо фаза ще не настала
+    static unsigned long getPhaseMillis(Phase phase) { return phaseMillis[phase]; }
+};
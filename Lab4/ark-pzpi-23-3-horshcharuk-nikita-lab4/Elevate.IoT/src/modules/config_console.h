@@ -0,0 +1,257 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ctype.h>
+#include "constants.h"
+#include "modules/config_manager.h"
+#include "modules/core_logic.h"
+#include "modules/scheduler.h"
+
+// ============================================================================
+// ConfigConsole - Зміна налаштувань через Serial без перепрошивки
+// ============================================================================
+// Команди рядками (115200, кінець рядка \n):
+//   config show                    збережені налаштування й чернетка
+//   config set <ключ> <значення>   змінити чернетку
+//   config save                    зберегти в NVS і застосувати без перезапуску
+//   config discard                 відкинути чернетку
+//   config defaults                значення прошивки в чернетку
+// Ключі: ssid, password, api, key, mode scan|dashboard, interval <мс>,
+// updates poll|sse, sleep on|off. Прийом будить loop() сповіщенням, як
+// переривання кнопок, тож консоль не опитується таймером
+class ConfigConsole {
+private:
+    static char input[Provisioning::CONSOLE_LINE_LENGTH + 1];
+    static size_t inputLength;
+    static bool overflow;
+    static bool awake;
+    static unsigned long lastInputAt;
+    static unsigned long commands;
+    
+    // Викликається задачею драйвера UART
+    static void onReceive() {
+        Scheduler::notify();
+    }
+    
+    // Слово до пробілу; курсор переходить на початок наступного
+    static char* takeWord(char*& cursor) {
+        while (*cursor == ' ') cursor++;
+        char* word = cursor;
+        while (*cursor != '\0' && *cursor != ' ') cursor++;
+        if (*cursor != '\0') *cursor++ = '\0';
+        while (*cursor == ' ') cursor++;
+        return word;
+    }
+    
+    static const char* copyText(char* target, size_t capacity, const char* value) {
+        size_t length = strlen(value);
+        if (length >= capacity) return "value too long";
+        memcpy(target, value, length + 1);
+        return nullptr;
+    }
+    
+    // Ключ іде в рядок запиту без екранування
+    static bool isUrlSafe(const char* value) {
+        for (; *value != '\0'; value++) {
+            if (!isalnum((unsigned char)*value) && strchr("-_.~", *value) == nullptr) return false;
+        }
+        return true;
+    }
+    
+    // nullptr — значення прийнято; інакше текст помилки
+    static const char* setValue(const char* key, const char* value) {
+        ConfigManager::Settings& draft = ConfigManager::getDraft();
+        
+        if (strcmp(key, "ssid") == 0) {
+            if (value[0] == '\0') return "ssid is empty";
+            return copyText(draft.wifiSsid, sizeof(draft.wifiSsid), value);
+        }
+        if (strcmp(key, "password") == 0) {
+            return copyText(draft.wifiPassword, sizeof(draft.wifiPassword), value);
+        }
+        if (strcmp(key, "api") == 0) {
+            // ApiClient ходить звичайним WiFiClient, тож лише http://
+            if (strncmp(value, "http://", 7) != 0 || value[7] == '\0' || strchr(value, ' ') != nullptr) {
+                return "expected http://host[:port]";
+            }
+            if (strcspn(value + 7, ":/") > Parsing::HOST_LENGTH) return "host too long";
+            return copyText(draft.apiBaseUrl, sizeof(draft.apiBaseUrl), value);
+        }
+        if (strcmp(key, "key") == 0) {
+            if (value[0] == '\0' || !isUrlSafe(value)) return "expected [A-Za-z0-9-_.~]";
+            return copyText(draft.deviceKey, sizeof(draft.deviceKey), value);
+        }
+        if (strcmp(key, "mode") == 0) {
+            if (strcmp(value, "scan") == 0) {
+                draft.mode = ConfigManager::SCAN_MODE;
+            } else if (strcmp(value, "dashboard") == 0) {
+                draft.mode = ConfigManager::DASHBOARD_MODE;
+            } else {
+                return "expected scan|dashboard";
+            }
+            return nullptr;
+        }
+        if (strcmp(key, "interval") == 0) {
+            char* end = nullptr;
+            unsigned long interval = strtoul(value, &end, 10);
+            if (end == value || *end != '\0' || interval < Provisioning::MIN_INTERVAL_MS ||
+                interval > Provisioning::MAX_INTERVAL_MS) {
+                return "expected milliseconds 1000..1800000";
+            }
+            draft.dashboardUpdateInterval = interval;
+            return nullptr;
+        }
+        if (strcmp(key, "updates") == 0) {
+            if (strcmp(value, "poll") == 0) {
+                draft.updateMode = ConfigManager::POLL_UPDATES;
+            } else if (strcmp(value, "sse") == 0) {
+                draft.updateMode = ConfigManager::STREAM_UPDATES;
+            } else {
+                return "expected poll|sse";
+            }
+            return nullptr;
+        }
+        if (strcmp(key, "sleep") == 0) {
+            if (strcmp(value, "on") != 0 && strcmp(value, "off") != 0) return "expected on|off";
+            draft.lightSleepIdle = strcmp(value, "on") == 0;
+            return nullptr;
+        }
+        return "unknown key";
+    }
+    
+    // Пароль не друкується
+    static void printSettings(const char* label, const ConfigManager::Settings& settings) {
+        Serial.printf("[config] %s ssid=%s password=%s api=%s key=%s\n", label,
+                      settings.wifiSsid, settings.wifiPassword[0] != '\0' ? "***" : "(none)",
+                      settings.apiBaseUrl, settings.deviceKey);
+        Serial.printf("[config] %s mode=%s interval=%lums updates=%s sleep=%s\n", label,
+                      settings.mode == ConfigManager::SCAN_MODE ? "scan" : "dashboard",
+                      (unsigned long)settings.dashboardUpdateInterval,
+                      settings.updateMode == ConfigManager::STREAM_UPDATES ? "sse" : "poll",
+                      settings.lightSleepIdle ? "on" : "off");
+    }
+    
+    static void printChanges(uint8_t changes) {
+        static const char* names[] = { "wifi", "backend", "mode", "interval", "updates", "sleep" };
+        for (int bit = 0; bit < 6; bit++) {
+            if (changes & (1 << bit)) Serial.printf(" %s", names[bit]);
+        }
+        Serial.println();
+    }
+    
+    static void show() {
+        Serial.printf("[config] source=%s load=%luus saves=%lu\n",
+                      ConfigManager::isLoadedFromNvs() ? "nvs" : "defaults",
+                      ConfigManager::getLoadMicros(),
+                      ConfigManager::getSaves());
+        printSettings("saved", ConfigManager::getStored());
+        
+        uint8_t changes = ConfigManager::getDraftChanges();
+        if (changes != 0) {
+            printSettings("draft", ConfigManager::getDraft());
+            Serial.print("[config] unsaved:");
+            printChanges(changes);
+        }
+    }
+    
+    static void save() {
+        uint8_t changes;
+        ConfigManager::CommitResult result = ConfigManager::commit(changes);
+        if (result == ConfigManager::COMMIT_BUSY) {
+            Serial.println("[config] busy: previous backend change is still applying, retry");
+        } else if (result == ConfigManager::COMMIT_FAILED) {
+            Serial.println("[config] error: NVS write failed, nothing applied");
+        } else if (changes == 0) {
+            Serial.println("[config] nothing to save");
+        } else {
+            CoreLogic::applySettings(changes);
+            Serial.print("[config] saved and applied:");
+            printChanges(changes);
+        }
+    }
+    
+    static void execute(char* text) {
+        char* cursor = text;
+        if (strcmp(takeWord(cursor), "config") != 0) {
+            if (text[0] != '\0') Serial.println("[config] unknown command, try \"config help\"");
+            return;
+        }
+        commands++;
+        
+        const char* verb = takeWord(cursor);
+        if (verb[0] == '\0' || strcmp(verb, "show") == 0) {
+            show();
+        } else if (strcmp(verb, "set") == 0) {
+            const char* key = takeWord(cursor);
+            const char* error = setValue(key, cursor);
+            if (error != nullptr) {
+                Serial.printf("[config] %s: %s\n", key, error);
+            } else {
+                Serial.printf("[config] %s staged, \"config save\" to apply\n", key);
+            }
+        } else if (strcmp(verb, "save") == 0) {
+            save();
+        } else if (strcmp(verb, "discard") == 0) {
+            ConfigManager::discardDraft();
+            Serial.println("[config] draft discarded");
+        } else if (strcmp(verb, "defaults") == 0) {
+            ConfigManager::setDefaults(ConfigManager::getDraft());
+            Serial.println("[config] firmware defaults staged, \"config save\" to apply");
+        } else {
+            Serial.println("[config] usage: config show | set <key> <value> | save | discard | defaults");
+            Serial.println("[config] keys: ssid password api key mode interval updates sleep");
+        }
+    }
+    
+public:
+    static void begin() {
+        Serial.onReceive(onReceive);
+        Serial.printf("[config] source=%s load=%luus, \"config help\" for commands\n",
+                      ConfigManager::isLoadedFromNvs() ? "nvs" : "defaults",
+                      ConfigManager::getLoadMicros());
+    }
+    
+    // Викликається з loop() на кожному пробудженні; читає лише те, що вже прийшло
+    static void service() {
+        while (Serial.available() > 0) {
+            int c = Serial.read();
+            if (c < 0) break;
+            
+            awake = true;
+            lastInputAt = millis();
+            if (c == '\r') continue;
+            
+            if (c == '\n') {
+                input[inputLength] = '\0';
+                // Кінцеві пробіли не належать значенню
+                while (inputLength > 0 && input[inputLength - 1] == ' ') input[--inputLength] = '\0';
+                if (overflow) {
+                    Serial.println("[config] line too long, ignored");
+                } else {
+                    execute(input);
+                }
+                inputLength = 0;
+                overflow = false;
+            } else if (inputLength < Provisioning::CONSOLE_LINE_LENGTH) {
+                input[inputLength++] = (char)c;
+            } else {
+                overflow = true;
+            }
+        }
+    }
+    
+    // Символи, що розбудили чип із light sleep, UART не приймає
+    static void markWake() {
+        awake = true;
+        lastInputAt = millis();
+        Serial.println("[config] woke by Serial, console awake; repeat the command");
+    }
+    
+    // Поки набирається рядок і ще CONSOLE_AWAKE_MS після нього light sleep
+    // не вмикається, інакше UART губить символи
+    static bool isAwake() {
+        return inputLength > 0 || (awake && millis() - lastInputAt < Power::CONSOLE_AWAKE_MS);
+    }
+    
+    static unsigned long getCommands() { return commands; }
+};
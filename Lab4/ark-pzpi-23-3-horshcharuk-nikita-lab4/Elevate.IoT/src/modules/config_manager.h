@@ -1,13 +1,49 @@
 #pragma once
 
+#include <Arduino.h>
+#include <Preferences.h>
 #include "constants.h"
 
 // ============================================================================
 // ConfigManager - Управління налаштуваннями
 // ============================================================================
+// Налаштування лежать у NVS одним блобом фіксованого формату, тож під час
+// старту це одне читання без жодного розбору. Якщо блобу немає або формат
+// інший, беруться значення з constants.h.
+// Зміни з консолі накопичуються в чернетці, а commit() зберігає її і
+// повідомляє, що саме змінилось. URL бекенду й ключ пристрою читає
+// мережева задача, тому в API_BASE_URL і DEVICE_KEY вони потрапляють
+// лише через applyBackend() у самій задачі
 class ConfigManager {
 public:
     enum Mode { SCAN_MODE, DASHBOARD_MODE };
+    enum UpdateMode { POLL_UPDATES, STREAM_UPDATES };
+    
+    // Біти результату commit(); кожна зміна застосовується по-своєму
+    enum Change : uint8_t {
+        WIFI_CHANGED = 1 << 0,
+        BACKEND_CHANGED = 1 << 1,
+        MODE_CHANGED = 1 << 2,
+        INTERVAL_CHANGED = 1 << 3,
+        UPDATES_CHANGED = 1 << 4,
+        SLEEP_CHANGED = 1 << 5
+    };
+    
+    enum CommitResult { COMMIT_OK, COMMIT_BUSY, COMMIT_FAILED };
+    
+    // Формат блобу в NVS; нове поле — новий FORMAT_VERSION
+    struct Settings {
+        uint16_t version;
+        uint16_t size;
+        char wifiSsid[Provisioning::SSID_LENGTH + 1];
+        char wifiPassword[Provisioning::PASSWORD_LENGTH + 1];
+        char apiBaseUrl[Provisioning::URL_LENGTH + 1];
+        char deviceKey[Provisioning::DEVICE_KEY_LENGTH + 1];
+        uint32_t dashboardUpdateInterval;
+        uint8_t mode;
+        uint8_t updateMode;
+        uint8_t lightSleepIdle;
+    };
     
     static const char* WIFI_SSID;
     static const char* WIFI_PASSWORD;
@@ -15,10 +51,138 @@ public:
     static const char* DEVICE_KEY;
     static Mode currentMode;
     static unsigned long dashboardUpdateInterval;
+    static UpdateMode updateMode;
+    static bool lightSleepIdle;
+    
+private:
+    static Settings stored;
+    static Settings draft;
+    static char apiBaseUrl[Provisioning::URL_LENGTH + 1];
+    static char deviceKey[Provisioning::DEVICE_KEY_LENGTH + 1];
+    static volatile bool backendPending;
+    static bool loadedFromNvs;
+    static unsigned long loadMicros;
+    static unsigned long saves;
+    
+    static bool isTerminated(const char* text, size_t capacity) {
+        return memchr(text, '\0', capacity) != nullptr;
+    }
+    
+    static bool isValid(const Settings& settings) {
+        return settings.version == Provisioning::FORMAT_VERSION &&
+               settings.size == sizeof(Settings) &&
+               isTerminated(settings.wifiSsid, sizeof(settings.wifiSsid)) &&
+               isTerminated(settings.wifiPassword, sizeof(settings.wifiPassword)) &&
+               isTerminated(settings.apiBaseUrl, sizeof(settings.apiBaseUrl)) &&
+               isTerminated(settings.deviceKey, sizeof(settings.deviceKey)) &&
+               settings.dashboardUpdateInterval >= Provisioning::MIN_INTERVAL_MS &&
+               settings.dashboardUpdateInterval <= Provisioning::MAX_INTERVAL_MS &&
+               settings.mode <= DASHBOARD_MODE && settings.updateMode <= STREAM_UPDATES;
+    }
+    
+    static bool load(Settings& settings) {
+        Preferences prefs;
+        if (!prefs.begin(Provisioning::NVS_NAMESPACE, true)) return false;
+        
+        size_t length = prefs.getBytes(Provisioning::NVS_KEY, &settings, sizeof(settings));
+        prefs.end();
+        return length == sizeof(settings) && isValid(settings);
+    }
+    
+    static bool save(const Settings& settings) {
+        Preferences prefs;
+        if (!prefs.begin(Provisioning::NVS_NAMESPACE, false)) return false;
+        
+        size_t written = prefs.putBytes(Provisioning::NVS_KEY, &settings, sizeof(settings));
+        prefs.end();
+        return written == sizeof(settings);
+    }
+    
+    static uint8_t diff(const Settings& from, const Settings& to) {
+        uint8_t changes = 0;
+        if (strcmp(from.wifiSsid, to.wifiSsid) != 0 || strcmp(from.wifiPassword, to.wifiPassword) != 0) {
+            changes |= WIFI_CHANGED;
+        }
+        if (strcmp(from.apiBaseUrl, to.apiBaseUrl) != 0 || strcmp(from.deviceKey, to.deviceKey) != 0) {
+            changes |= BACKEND_CHANGED;
+        }
+        if (from.mode != to.mode) changes |= MODE_CHANGED;
+        if (from.dashboardUpdateInterval != to.dashboardUpdateInterval) changes |= INTERVAL_CHANGED;
+        if (from.updateMode != to.updateMode) changes |= UPDATES_CHANGED;
+        if (from.lightSleepIdle != to.lightSleepIdle) changes |= SLEEP_CHANGED;
+        return changes;
+    }
+    
+    // Поля, які читає лише loop(), застосовуються одразу
+    static void applyLocal() {
+        WIFI_SSID = stored.wifiSsid;
+        WIFI_PASSWORD = stored.wifiPassword;
+        currentMode = (Mode)stored.mode;
+        dashboardUpdateInterval = stored.dashboardUpdateInterval;
+        updateMode = (UpdateMode)stored.updateMode;
+        lightSleepIdle = stored.lightSleepIdle != 0;
+    }
     
+public:
     static void initialize() {
-        currentMode = SCAN_MODE;
-        dashboardUpdateInterval = Timing::DASHBOARD_UPDATE_INTERVAL_MS;
+        unsigned long start = micros();
+        loadedFromNvs = load(stored);
+        if (!loadedFromNvs) setDefaults(stored);
+        loadMicros = micros() - start;
+        
+        draft = stored;
+        applyLocal();
+        applyBackend();
     }
+    
+    static void setDefaults(Settings& settings) {
+        // Нулі і в запасі рядків, і у вирівнюванні: блоб завжди однаковий
+        memset(&settings, 0, sizeof(settings));
+        settings.version = Provisioning::FORMAT_VERSION;
+        settings.size = sizeof(Settings);
+        strncpy(settings.wifiSsid, Config::WIFI_SSID, sizeof(settings.wifiSsid) - 1);
+        strncpy(settings.wifiPassword, Config::WIFI_PASSWORD, sizeof(settings.wifiPassword) - 1);
+        strncpy(settings.apiBaseUrl, Config::API_BASE_URL, sizeof(settings.apiBaseUrl) - 1);
+        strncpy(settings.deviceKey, Config::DEVICE_KEY, sizeof(settings.deviceKey) - 1);
+        settings.dashboardUpdateInterval = Timing::DASHBOARD_UPDATE_INTERVAL_MS;
+        settings.mode = Config::START_IN_DASHBOARD ? DASHBOARD_MODE : SCAN_MODE;
+        settings.updateMode = Config::LEADERBOARD_STREAM ? STREAM_UPDATES : POLL_UPDATES;
+        settings.lightSleepIdle = Config::LIGHT_SLEEP_IDLE;
+    }
+    
+    // Чернетку змінює лише консоль у loop()
+    static Settings& getDraft() { return draft; }
+    static const Settings& getStored() { return stored; }
+    static void discardDraft() { draft = stored; }
+    static uint8_t getDraftChanges() { return diff(stored, draft); }
+    
+    // Поки мережева задача не забрала попередній бекенд, stored не чіпаємо
+    static CommitResult commit(uint8_t& changes) {
+        changes = 0;
+        if (backendPending) return COMMIT_BUSY;
+        
+        uint8_t pending = diff(stored, draft);
+        if (pending == 0) return COMMIT_OK;
+        if (!save(draft)) return COMMIT_FAILED;
+        
+        stored = draft;
+        saves++;
+        if (pending & BACKEND_CHANGED) backendPending = true;
+        applyLocal();
+        changes = pending;
+        return COMMIT_OK;
+    }
+    
+    // Мережева задача між запитами (і setup() до її старту)
+    static void applyBackend() {
+        memcpy(apiBaseUrl, stored.apiBaseUrl, sizeof(apiBaseUrl));
+        memcpy(deviceKey, stored.deviceKey, sizeof(deviceKey));
+        API_BASE_URL = apiBaseUrl;
+        DEVICE_KEY = deviceKey;
+        backendPending = false;
+    }
+    
+    static bool isLoadedFromNvs() { return loadedFromNvs; }
+    static unsigned long getLoadMicros() { return loadMicros; }
+    static unsigned long getSaves() { return saves; }
 };
-
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_freertos_hooks.h>
+
+// ============================================================================
+// CoreLoad - Завантаження кожного ядра за вибірками з тік-переривання
+// ============================================================================
+// У light sleep тіків немає, тож частки рахуються від часу без сну
+class CoreLoad {
+public:
+    static const int CORE_COUNT = 2;
+    
+private:
+    static TaskHandle_t idleTasks[CORE_COUNT];
+    static TaskHandle_t pipelineTasks[CORE_COUNT];
+    static const char* pipelineNames[CORE_COUNT];
+    static volatile uint32_t ticks[CORE_COUNT];
+    static volatile uint32_t idleTicks[CORE_COUNT];
+    static volatile uint32_t pipelineTicks[CORE_COUNT];
+    
+    static void IRAM_ATTR sample(int core) {
+        TaskHandle_t current = xTaskGetCurrentTaskHandleForCPU(core);
+        ticks[core]++;
+        if (current == idleTasks[core]) {
+            idleTicks[core]++;
+        } else if (current == pipelineTasks[core]) {
+            pipelineTicks[core]++;
+        }
+    }
+    
+    static void IRAM_ATTR sampleCore0() { sample(0); }
+    static void IRAM_ATTR sampleCore1() { sample(1); }
+    
+    static unsigned long percent(uint32_t part, uint32_t total) {
+        return total > 0 ? (unsigned long)((uint64_t)part * 100 / total) : 0;
+    }
+    
+public:
+    static void begin() {
+        for (int core = 0; core < CORE_COUNT; core++) {
+            idleTasks[core] = xTaskGetIdleTaskHandleForCPU(core);
+            pipelineNames[core] = "none";
+        }
+        esp_register_freertos_tick_hook_for_cpu(sampleCore0, 0);
+        esp_register_freertos_tick_hook_for_cpu(sampleCore1, 1);
+    }
+    
+    // Викликається з самої задачі конвеєра, вже на її ядрі
+    static void attach(const char* name) {
+        int core = xPortGetCoreID();
+        pipelineNames[core] = name;
+        pipelineTasks[core] = xTaskGetCurrentTaskHandle();
+    }
+    
+    static unsigned long getBusyPercent(int core) {
+        uint32_t total = ticks[core];
+        return total > 0 ? 100 - percent(idleTicks[core], total) : 0;
+    }
+    
+    static unsigned long getPipelinePercent(int core) { return percent(pipelineTicks[core], ticks[core]); }
+    static const char* getPipelineName(int core) { return pipelineNames[core]; }
+};
@@ -4,87 +4,423 @@
 #include "types.h"
 #include "modules/config_manager.h"
 #include "modules/badge_reader.h"
-#include "modules/api_client.h"
+#include "modules/network_worker.h"
+#include "modules/scan_journal.h"
+#include "modules/profile_cache.h"
+#include "modules/leaderboard_stream.h"
+#include "modules/dashboard_poller.h"
 #include "modules/led_display.h"
 #include "modules/leaderboard_button.h"
+#include "modules/input_events.h"
+#include "modules/scheduler.h"
+#include "modules/boot_trace.h"
+#include "modules/latency_stats.h"
 
 // ============================================================================
 // CoreLogic - Головна бізнес-логіка
 // ============================================================================
 class CoreLogic {
+public:
+    // Що зараз на екрані в режимі сканування
+    enum UiState : uint8_t {
+        IDLE_STATE,        // "Waiting for scan..."
+        STATUS_STATE,      // стан системи після старту
+        SCANNING_STATE,    // запит у дорозі; "Scanning" або профіль із кешу
+        RESULT_STATE,      // профіль чи помилка до дедлайну HOLD_TIMER
+        LEADERBOARD_STATE, // таблиця до дедлайну HOLD_TIMER
+        DIAGNOSTICS_STATE  // гістограми затримок до дедлайну HOLD_TIMER
+    };
+    
 private:
-    static unsigned long lastDashboardUpdate;
-    static unsigned long lastWaitingMessage;
+    static UiState uiState;
+    static int pendingRequests;
+    static int provisionalUserId;
+    static unsigned long skippedRedraws;
+    static unsigned long journalBackoffMs;
+    static unsigned long lastScanResultAt;
+    static uint8_t configChanges;
+    
+    // Екран лишається до дедлайну, а події тим часом обробляються
+    static void showUntil(UiState state, unsigned long duration) {
+        uiState = state;
+        Scheduler::after(Scheduler::HOLD_TIMER, duration, enterIdle);
+    }
     
-    static bool isNetworkError(const String& error) {
-        return error.indexOf("server") >= 0 || 
-               error.indexOf("unavailable") >= 0 ||
-               error.indexOf("HTTP") >= 0 ||
-               error.indexOf("connection") >= 0 ||
-               error.indexOf("timeout") >= 0;
+    static void enterIdle() {
+        uiState = IDLE_STATE;
+        LedDisplay::showWaitingMessage();
     }
     
-    static void showLeaderboardOnDemand() {
-        LeaderboardEntry entries[5];
-        if (ApiClient::getLeaderboard(entries, 5)) {
-            LedDisplay::showLeaderboard(entries, 5);
+    static void enterScanning() {
+        uiState = SCANNING_STATE;
+        Scheduler::cancel(Scheduler::HOLD_TIMER);
+    }
+    
+    // Якщо на екрані вже попередній профіль із кешу, відповідь сервера
+    // оновлює лише змінені рядки на тому ж екрані
+    static void showScanResult(const NetworkWorker::Completion& done, const ScanResult& result) {
+        int userId = done.userId;
+        bool wasProvisional = (userId == provisionalUserId);
+        if (wasProvisional) provisionalUserId = 0;
+        
+        if (result.success) {
+            LedDisplay::incrementSuccessfulScan();
+            ProfileCache::store(result);
+            LedDisplay::showUserProfile(result);
+            if (!wasProvisional) {
+                ProfileCache::recordFirstPixel(false, (millis() - done.postedAt) * 1000UL);
+            }
+        } else {
+            LedDisplay::incrementFailedScan();
+            const ScanResult* cached = wasProvisional ? ProfileCache::peek(userId) : nullptr;
+            bool offline = isRetryableError(result.error);
+            if (offline) armJournalDrain();
+            
+            if (cached != nullptr && offline) {
+                LedDisplay::showUserProfile(*cached, "Offline: saved for later");
+            } else if (offline) {
+                LedDisplay::showOfflineInfo();
+            } else {
+                ErrorText errorText;
+                ApiClient::formatError(result, errorText);
+                FixedString<Display::MAX_ERROR_MESSAGE_LENGTH + 16> errorMsg;
+                errorMsg.format("User ID %d: %s", userId, errorText.c_str());
+                LedDisplay::showError(errorMsg.c_str());
+            }
+        }
+        showUntil(RESULT_STATE, Timing::SCAN_RESULT_DISPLAY_MS);
+        lastScanResultAt = millis();
+        
+        if (done.inputAt != 0) {
+            LatencyStats::recordSince(LatencyStats::SCAN_STAGE, done.inputAt);
+        }
+    }
+    
+    // Скан завершився вже після переходу в дашборд: екран не чіпаємо,
+    // але профіль іде в кеш, а скан із журналу чекає вивантаження
+    static void dropScanResult(const ScanResult& result) {
+        provisionalUserId = 0;
+        if (result.success) {
+            ProfileCache::store(result);
+        } else if (isRetryableError(result.error)) {
+            armJournalDrain();
+        }
+    }
+    
+    // Повторне натискання кнопки лідерборду, поки таблиця на екрані,
+    // відкриває діагностику
+    static void showDiagnostics() {
+        LedDisplay::showDiagnostics();
+        LatencyStats::dump();
+        showUntil(DIAGNOSTICS_STATE, Timing::DIAGNOSTICS_DISPLAY_MS);
+    }
+    
+    static void showLeaderboardResult(const NetworkWorker::Completion& done) {
+        // Те саме табло вже на екрані — нічого не малюємо
+        if (done.success && done.unchanged &&
+            RetainedScreen::getCurrentScreen() == RetainedScreen::LEADERBOARD_SCREEN) {
+            skippedRedraws++;
+            LedDisplay::refreshPollFooter();
+        } else if (done.success) {
+            LedDisplay::showLeaderboard(NetworkWorker::getLeaderboard(done.slot),
+                                        Display::MAX_LEADERBOARD_ENTRIES);
         } else {
             LedDisplay::showOfflineInfo();
         }
+        
+        if (ConfigManager::currentMode == ConfigManager::SCAN_MODE) {
+            showUntil(LEADERBOARD_STATE, Timing::LEADERBOARD_DISPLAY_MS);
+        }
     }
     
-public:
-    static void handleScanMode() {
-        if (LeaderboardButton::isPressed()) {
-            showLeaderboardOnDemand();
-            delay(2000);
+    // Профіль із кешу малюється одразу, ще до відповіді сервера
+    static void startScan(int userId, uint32_t inputAt = 0) {
+        if (!postRequest(NetworkWorker::SCAN_JOB, userId, 0, inputAt)) return;
+        
+        enterScanning();
+        unsigned long start = micros();
+        const ScanResult* cached = ProfileCache::find(userId);
+        if (cached != nullptr) {
+            LedDisplay::showUserProfile(*cached, "Updating...");
+            ProfileCache::recordFirstPixel(true, micros() - start);
+            provisionalUserId = userId;
+        } else {
+            LedDisplay::showScanning(userId);
+        }
+    }
+    
+    static void showUnknownCard() {
+        LedDisplay::incrementFailedScan();
+        LedDisplay::showError("Unknown card");
+        showUntil(RESULT_STATE, Timing::SCAN_RESULT_DISPLAY_MS);
+    }
+    
+    // Картки немає у флеш-таблиці — одноразово питаємо сервер
+    static void resolveCard(uint64_t cardKey) {
+        if (postRequest(NetworkWorker::CARD_LOOKUP_JOB, 0, cardKey)) {
+            enterScanning();
+            UidText uid;
+            BadgeDirectory::formatUid(cardKey, uid);
+            LedDisplay::showScanningCard(uid.c_str());
+        }
+    }
+    
+    static void showCardLookupResult(const NetworkWorker::Completion& done) {
+        if (!done.success) {
+            LedDisplay::incrementFailedScan();
+            LedDisplay::showOfflineInfo();
+            showUntil(RESULT_STATE, Timing::SCAN_RESULT_DISPLAY_MS);
             return;
         }
         
-        if (BadgeReader::hasNewScan()) {
-            int userId = BadgeReader::getLastUserId();
-            ScanResult result = ApiClient::scanUser(userId);
+        BadgeDirectory::remember(done.cardKey, done.userId);
+        if (done.userId > 0) {
+            startScan(done.userId);
+        } else {
+            showUnknownCard();
+        }
+    }
+    
+    static void processCompletions() {
+        NetworkWorker::Completion done;
+        while (NetworkWorker::pollResult(done)) {
+            if (done.type == NetworkWorker::STREAM_UPDATE) {
+                if (ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE) {
+                    DashboardPoller::recordStreamUpdate();
+                    showLeaderboardResult(done);
+                }
+                continue;
+            }
             
-            if (result.success) {
-                LedDisplay::incrementSuccessfulScan();
-                LedDisplay::showUserProfile(result);
-            } else {
-                LedDisplay::incrementFailedScan();
-                String errorMsg = "User ID " + String(userId) + ": " + result.errorMessage;
-                
-                if (isNetworkError(result.errorMessage)) {
-                    LedDisplay::showOfflineInfo();
+            pendingRequests--;
+            bool scanMode = ConfigManager::currentMode == ConfigManager::SCAN_MODE;
+            
+            if (done.type == NetworkWorker::SCAN_JOB) {
+                const ScanResult& result = NetworkWorker::getScanResult(done.slot);
+                if (scanMode) {
+                    showScanResult(done, result);
                 } else {
-                    LedDisplay::showError(errorMsg);
+                    dropScanResult(result);
                 }
+            } else if (done.type == NetworkWorker::JOURNAL_DRAIN_JOB) {
+                scheduleJournalDrain(done.success);
+            } else if (done.type == NetworkWorker::CARD_LOOKUP_JOB) {
+                if (scanMode) {
+                    showCardLookupResult(done);
+                } else if (done.success) {
+                    BadgeDirectory::remember(done.cardKey, done.userId);
+                }
+            } else if (done.type == NetworkWorker::PROBE_JOB) {
+                BootTrace::mark(BootTrace::API_PHASE);
+                LedDisplay::setApiReachable(done.success);
+                refreshStatusScreen();
+            } else if (done.type == NetworkWorker::CONFIG_JOB) {
+                onConfigApplied(done.userId);
+            } else {
+                // Спершу новий інтервал, щоб підвал табло показав уже його
+                bool dashboard = ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE;
+                if (dashboard) DashboardPoller::recordResult(done.success, done.unchanged);
+                showLeaderboardResult(done);
+                if (dashboard) armDashboard();
             }
-            
-            delay(Timing::SCAN_RESULT_DISPLAY_MS);
+        }
+    }
+    
+    // Після вдалого пакета наступний іде одразу, після невдалого — з
+    // подвоєною затримкою, щоб не займати мережу, поки бекенд лежить
+    static void scheduleJournalDrain(bool delivered) {
+        if (delivered) {
+            journalBackoffMs = 0;
+        } else if (journalBackoffMs == 0) {
+            journalBackoffMs = Timing::JOURNAL_RETRY_MIN_MS;
         } else {
-            unsigned long now = millis();
-            if (now - lastWaitingMessage >= Timing::WAITING_MESSAGE_INTERVAL_MS) {
-                LedDisplay::showWaitingMessage();
-                lastWaitingMessage = now;
-            }
+            journalBackoffMs = min(journalBackoffMs * 2, Timing::JOURNAL_RETRY_MAX_MS);
         }
+        Scheduler::after(Scheduler::JOURNAL_TIMER, journalBackoffMs, drainJournal);
     }
     
-    static void handleDashboardMode() {
-        unsigned long now = millis();
+    // Після нового запису в журналі: якщо вивантаження ще не заплановане
+    static void armJournalDrain() {
+        if (Scheduler::isArmed(Scheduler::JOURNAL_TIMER)) return;
+        Scheduler::after(Scheduler::JOURNAL_TIMER, max(journalBackoffMs, Timing::JOURNAL_RETRY_MIN_MS),
+                         drainJournal);
+    }
+    
+    // Журнал вивантажується лише у простої, коли немає живих запитів;
+    // інакше спроба переноситься
+    static void drainJournal() {
+        if (ScanJournal::getPendingRecords() == 0) return;
         
-        if (now - lastDashboardUpdate >= ConfigManager::dashboardUpdateInterval) {
-            lastDashboardUpdate = now;
+        if (pendingRequests > 0 || !WiFiManager::isConnected() ||
+            !postRequest(NetworkWorker::JOURNAL_DRAIN_JOB)) {
+            Scheduler::after(Scheduler::JOURNAL_TIMER, Timing::JOURNAL_RETRY_MIN_MS, drainJournal);
+        }
+    }
+    
+    static void refreshStatusScreen() {
+        if (RetainedScreen::getCurrentScreen() == RetainedScreen::STATUS_SCREEN) {
+            LedDisplay::showSystemStatus();
+        }
+    }
+    
+    // Таблиця дашборду йде першою: pollLeaderboard() відкладає запит,
+    // поки в дорозі будь-який інший
+    static void onNetworkUp() {
+        BootTrace::mark(BootTrace::WIFI_PHASE);
+        
+        if (ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE) {
+            pollLeaderboard();
+        }
+        
+        journalBackoffMs = 0;
+        Scheduler::cancel(Scheduler::JOURNAL_TIMER);
+        drainJournal();
+        
+        postRequest(NetworkWorker::PROBE_JOB);
+        refreshStatusScreen();
+    }
+    
+    // Мережева задача вже перейшла на нові налаштування: перша таблиця
+    // нового режиму чи бекенду йде одразу, без очікування інтервалу
+    static void onConfigApplied(uint8_t changes) {
+        bool online = WiFiManager::isConnected();
+        if (online && ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE) {
+            DashboardPoller::reset();
+            pollLeaderboard();
+        }
+        if (!(changes & ConfigManager::BACKEND_CHANGED)) return;
+        
+        // Профілі з кешу й результат перевірки належали старому бекенду
+        ProfileCache::clear();
+        LedDisplay::resetApiState();
+        if (online) postRequest(NetworkWorker::PROBE_JOB);
+        refreshStatusScreen();
+    }
+    
+    // Якщо черга мережевої задачі повна, біти чекають наступного
+    // пробудження: його дасть завершення одного з тих запитів
+    static void postConfig() {
+        if (configChanges == 0) return;
+        if (postRequest(NetworkWorker::CONFIG_JOB, configChanges)) configChanges = 0;
+    }
+    
+    // Наступне опитування рахується від відповіді, а не від запиту
+    static void armDashboard() {
+        Scheduler::after(Scheduler::DASHBOARD_TIMER, DashboardPoller::getNextDelay(), pollLeaderboard);
+    }
+    
+    // Екран стану й таймери поточного режиму; у дашборді перший запит
+    // робить onNetworkUp() чи onConfigApplied()
+    static void enterMode() {
+        LedDisplay::showSystemStatus();
+        Scheduler::cancel(Scheduler::DASHBOARD_TIMER);
+        
+        if (ConfigManager::currentMode == ConfigManager::SCAN_MODE) {
+            showUntil(STATUS_STATE, Timing::SYSTEM_STATUS_DISPLAY_MS);
+            return;
+        }
+        
+        // Екран стану лишається до першої таблиці
+        Scheduler::cancel(Scheduler::HOLD_TIMER);
+        DashboardPoller::reset();
+        armDashboard();
+    }
+    
+    // Поки потік підключений чи інший запит у дорозі, опитування
+    // переноситься на наступний інтервал; інакше таймер знову заводить
+    // відповідь
+    static void pollLeaderboard() {
+        if (LeaderboardStream::isConnected() || pendingRequests > 0 ||
+            !postRequest(NetworkWorker::LEADERBOARD_JOB)) {
+            armDashboard();
+            return;
+        }
+        Scheduler::cancel(Scheduler::DASHBOARD_TIMER);
+        DashboardPoller::recordPoll();
+    }
+    
+    static bool postRequest(NetworkWorker::JobType type, int userId = 0, uint64_t cardKey = 0,
+                            uint32_t inputAt = 0) {
+        if (!NetworkWorker::post(type, userId, cardKey, inputAt)) return false;
+        pendingRequests++;
+        return true;
+    }
+    
+public:
+    // Таймери режиму; решту роботи loop() робить лише тоді, коли його
+    // розбудили події чи дедлайн
+    static void start() {
+        enterMode();
+    }
+    
+    // Збережені з консолі налаштування діють одразу, без перезапуску.
+    // Бекенд і режим оновлень застосовує мережева задача
+    static void applySettings(uint8_t changes) {
+        if (changes & ConfigManager::WIFI_CHANGED) WiFiManager::rejoin();
+        
+        if (changes & (ConfigManager::BACKEND_CHANGED | ConfigManager::MODE_CHANGED |
+                       ConfigManager::UPDATES_CHANGED)) {
+            configChanges |= changes;
+            postConfig();
+        }
+        
+        if (changes & ConfigManager::MODE_CHANGED) {
+            enterMode();
+        } else if ((changes & ConfigManager::INTERVAL_CHANGED) &&
+                   ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE) {
+            DashboardPoller::reset();
+            armDashboard();
+        } else {
+            refreshStatusScreen();
+        }
+    }
+    
+    static void handleScanMode() {
+        processCompletions();
+        
+        // Натискання накопичуються в кільці з переривань, тож жодне не
+        // губиться, поки триває запит або показується результат
+        InputEvent event;
+        while (InputEvents::poll(event)) {
+            if (LeaderboardButton::isPressed(event)) {
+                if (uiState == LEADERBOARD_STATE) {
+                    showDiagnostics();
+                } else {
+                    postRequest(NetworkWorker::LEADERBOARD_JOB);
+                }
+                continue;
+            }
             
-            LeaderboardEntry entries[5];
-            if (ApiClient::getLeaderboard(entries, 5)) {
-                LedDisplay::showLeaderboard(entries, 5);
-            } else {
-                LedDisplay::showOfflineInfo();
+            int userId = BadgeReader::readUserId(event);
+            uint64_t cardKey;
+            if (userId > 0) {
+                startScan(userId, event.timestampUs);
+            } else if (userId == BadgeDirectory::UNKNOWN_CARD) {
+                showUnknownCard();
+            } else if (BadgeReader::takeUnresolvedCard(cardKey)) {
+                resolveCard(cardKey);
             }
         }
     }
     
+    static void handleDashboardMode() {
+        processCompletions();
+        
+        // У режимі дашборду кнопки не використовуються
+        InputEvent event;
+        while (InputEvents::poll(event)) {}
+    }
+    
+    static UiState getUiState() { return uiState; }
+    static int getPendingRequests() { return pendingRequests; }
+    static unsigned long getSkippedRedraws() { return skippedRedraws; }
+    static unsigned long getLastScanResultAt() { return lastScanResultAt; }
+    
     static void run() {
+        postConfig();
+        WiFiManager::service();
+        if (WiFiManager::takeLinkUp()) onNetworkUp();
+        
         if (ConfigManager::currentMode == ConfigManager::SCAN_MODE) {
             handleScanMode();
         } else {
@@ -92,4 +428,3 @@ public:
         }
     }
 };
-
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "modules/config_manager.h"
+
+// ============================================================================
+// DashboardPoller - Адаптивний інтервал опитування лідерборду
+// ============================================================================
+// Джитер не дає дашбордам парку опитувати бекенд синхронно
+class DashboardPoller {
+private:
+    static unsigned long intervalMs;
+    static bool hasBaseline;
+    static bool hasData;
+    static unsigned long lastPollAt;
+    static unsigned long averageGapMs;
+    static unsigned long lastFreshAt;
+    static unsigned long polls;
+    static unsigned long changedResults;
+    static unsigned long failedResults;
+    
+    // Налаштований інтервал завжди в межах адаптації
+    static unsigned long getFloor() {
+        return min(Timing::DASHBOARD_MIN_INTERVAL_MS, ConfigManager::dashboardUpdateInterval);
+    }
+    
+    static unsigned long getCeiling() {
+        return max(Timing::DASHBOARD_MAX_INTERVAL_MS, ConfigManager::dashboardUpdateInterval);
+    }
+    
+public:
+    // Новий режим, інтервал чи бекенд: перша відповідь стає точкою відліку
+    static void reset() {
+        intervalMs = ConfigManager::dashboardUpdateInterval;
+        hasBaseline = false;
+    }
+    
+    // Той самий джитер дає LeaderboardStream паузам між спробами
+    static unsigned long withJitter(unsigned long delayMs) {
+        unsigned long spread = delayMs * Timing::DASHBOARD_JITTER_PERCENT / 100;
+        if (spread == 0) return delayMs;
+        return delayMs - spread + esp_random() % (2 * spread + 1);
+    }
+    
+    static unsigned long getNextDelay() {
+        return withJitter(intervalMs);
+    }
+    
+    static void recordPoll() {
+        unsigned long now = millis();
+        if (polls > 0) {
+            unsigned long gap = now - lastPollAt;
+            averageGapMs = averageGapMs == 0 ? gap : (averageGapMs * 3 + gap) / 4;
+        }
+        lastPollAt = now;
+        polls++;
+    }
+    
+    // 304 і та сама таблиця — unchanged; обидва підтверджують, що дані свіжі
+    static void recordResult(bool success, bool unchanged) {
+        if (!success) {
+            failedResults++;
+            intervalMs = min(intervalMs * 2, getCeiling());
+            return;
+        }
+        
+        lastFreshAt = millis();
+        hasData = true;
+        if (!hasBaseline) {
+            hasBaseline = true;
+        } else if (unchanged) {
+            intervalMs = min(intervalMs * 3 / 2, getCeiling());
+        } else {
+            changedResults++;
+            intervalMs = max(intervalMs / 2, getFloor());
+        }
+    }
+    
+    // Подія потоку теж оновлює таблицю на екрані
+    static void recordStreamUpdate() {
+        lastFreshAt = millis();
+        hasData = true;
+    }
+    
+    static unsigned long getIntervalMs() { return intervalMs; }
+    static bool hasFreshData() { return hasData; }
+    static unsigned long getStalenessMs() { return hasData ? millis() - lastFreshAt : 0; }
+    
+    // Десяті частки запиту на хвилину. Поки опитування немає, пауза з
+    // останнього запиту тягне оцінку до нуля
+    static unsigned long getRequestRateTenths() {
+        if (polls < 2) return 0;
+        unsigned long gap = max(averageGapMs, millis() - lastPollAt);
+        return gap > 0 ? 600000UL / gap : 0;
+    }
+    
+    static unsigned long getPolls() { return polls; }
+    static unsigned long getChangedResults() { return changedResults; }
+    static unsigned long getFailedResults() { return failedResults; }
+};
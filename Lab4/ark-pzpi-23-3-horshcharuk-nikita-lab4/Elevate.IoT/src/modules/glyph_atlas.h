@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "display.h"
+
+// ============================================================================
+// GlyphAtlas - Растризований шрифт для виводу рядка одним вікном
+// ============================================================================
+// Класичний шрифт GFX один раз під час старту розкладається в атлас:
+// для кожного з 256 кодів 8 рядків по 6 біт (старший біт - лівий піксель),
+// тож символи поза ASCII виглядають так само, як через drawChar().
+// Масштаб не зберігається: при виводі кожен біт і кожен рядок просто
+// повторюються size разів, тож атлас однаковий для всіх розмірів тексту
+class GlyphAtlas {
+public:
+    static const int GLYPH_WIDTH = 6;
+    static const int GLYPH_HEIGHT = 8;
+
+private:
+    static const int GLYPH_COUNT = 256;
+    
+    static uint8_t rows[GLYPH_COUNT][GLYPH_HEIGHT];
+    static bool built;
+    static unsigned long buildMicros;
+
+public:
+    static void build() {
+        if (built) return;
+        
+        unsigned long start = micros();
+        GFXcanvas1 cell(GLYPH_WIDTH, GLYPH_HEIGHT);
+        for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+            cell.fillScreen(0);
+            cell.drawChar(0, 0, glyph, 1, 0, 1);
+            
+            for (int y = 0; y < GLYPH_HEIGHT; y++) {
+                uint8_t bits = 0;
+                for (int x = 0; x < GLYPH_WIDTH; x++) {
+                    bits = (bits << 1) | (cell.getPixel(x, y) ? 1 : 0);
+                }
+                rows[glyph][y] = bits;
+            }
+        }
+        buildMicros = micros() - start;
+        built = true;
+    }
+    
+    // Біти рядка y символу c
+    static uint8_t getRow(char c, int y) {
+        return rows[(uint8_t)c][y];
+    }
+    
+    static bool isBuilt() { return built; }
+    static unsigned long getBuildMicros() { return buildMicros; }
+    static size_t getBytes() { return sizeof(rows); }
+};
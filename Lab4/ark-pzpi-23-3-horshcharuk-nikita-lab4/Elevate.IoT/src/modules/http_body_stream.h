@@ -0,0 +1,197 @@
+#pragma once
+
+#include <Arduino.h>
+#include "modules/latency_stats.h"
+
+// ============================================================================
+// HttpBodyStream - Потокове читання тіла HTTP-відповіді з сокета
+// ============================================================================
+// Віддає рівно тіло відповіді (Content-Length або chunked), щоб парсер
+// читав прямо з WiFiClient, а сокет лишався придатним для keep-alive
+class HttpBodyStream : public Stream {
+private:
+    Stream& source;
+    bool chunked;
+    bool finished;
+    long remaining;
+    int peeked;
+    const char* buffered;
+    size_t bufferedLength;
+    size_t bufferedPosition;
+    unsigned long bytesRead;
+    uint32_t contentHash;
+    uint32_t waitCycles;
+    
+    int readRaw() {
+        char c;
+        uint32_t start = LatencyStats::now();
+        size_t count = source.readBytes(&c, 1);
+        waitCycles += LatencyStats::now() - start;
+        return count == 1 ? (uint8_t)c : -1;
+    }
+    
+    bool readChunkSize() {
+        long size = 0;
+        bool hasDigits = false;
+        bool inExtension = false;
+        
+        for (;;) {
+            int c = readRaw();
+            if (c < 0) return false;
+            if (c == '\n') break;
+            if (c == ';') inExtension = true;
+            if (inExtension) continue;
+            
+            int digit = -1;
+            if (c >= '0' && c <= '9') digit = c - '0';
+            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+            
+            if (digit >= 0) {
+                size = size * 16 + digit;
+                hasDigits = true;
+            }
+        }
+        
+        if (!hasDigits) return false;
+        remaining = size;
+        return true;
+    }
+    
+    void skipLine() {
+        int c;
+        do {
+            c = readRaw();
+        } while (c >= 0 && c != '\n');
+    }
+    
+    int nextByte() {
+        if (finished) return -1;
+        
+        if (chunked && remaining == 0) {
+            if (!readChunkSize()) {
+                finished = true;
+                return -1;
+            }
+            if (remaining == 0) {
+                skipLine(); // порожній рядок після останнього чанку
+                finished = true;
+                return -1;
+            }
+        }
+        
+        int c = readRaw();
+        if (c < 0) {
+            finished = true;
+            return -1;
+        }
+        
+        bytesRead++;
+        contentHash = (contentHash ^ (uint8_t)c) * 16777619UL;
+        if (remaining > 0) {
+            remaining--;
+            if (remaining == 0) {
+                if (chunked) {
+                    skipLine(); // CRLF після даних чанку
+                } else {
+                    finished = true;
+                }
+            }
+        }
+        return c;
+    }
+    
+    // Спершу байти, прочитані prefetch(), далі сокет
+    int takeByte() {
+        if (bufferedPosition < bufferedLength) return (uint8_t)buffered[bufferedPosition++];
+        return nextByte();
+    }
+    
+public:
+    // contentLength < 0 означає, що довжина невідома (chunked або до закриття)
+    HttpBodyStream(Stream& stream, long contentLength, bool isChunked)
+        : source(stream), chunked(isChunked), finished(contentLength == 0 && !isChunked),
+          remaining(isChunked ? 0 : contentLength), peeked(-1), buffered(nullptr),
+          bufferedLength(0), bufferedPosition(0), bytesRead(0),
+          contentHash(2166136261UL), waitCycles(0) {}
+    
+    // Для довгого з'єднання: той самий сокет, нова відповідь
+    void reset(long contentLength, bool isChunked) {
+        chunked = isChunked;
+        finished = (contentLength == 0 && !isChunked);
+        remaining = isChunked ? 0 : contentLength;
+        peeked = -1;
+        buffered = nullptr;
+        bufferedLength = 0;
+        bufferedPosition = 0;
+        bytesRead = 0;
+        contentHash = 2166136261UL;
+        waitCycles = 0;
+    }
+    
+    int available() override {
+        if (peeked >= 0 || bufferedPosition < bufferedLength) return 1;
+        if (finished) return 0;
+        return source.available() > 0 ? 1 : 0;
+    }
+    
+    int read() override {
+        if (peeked >= 0) {
+            int c = peeked;
+            peeked = -1;
+            return c;
+        }
+        return takeByte();
+    }
+    
+    int peek() override {
+        if (peeked < 0) peeked = takeByte();
+        return peeked;
+    }
+    
+    size_t write(uint8_t) override { return 0; }
+    
+    // На відміну від readBytes() не чекає таймауту, коли тіло закінчилось
+    size_t readInto(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[count++] = (char)c;
+        }
+        return count;
+    }
+    
+    // Дочитує залишок тіла, щоб наступна відповідь на цьому сокеті
+    // не почалася зі сміття
+    void drain() {
+        peeked = -1;
+        bufferedPosition = bufferedLength;
+        if (remaining < 0) return; // тіло до закриття з'єднання
+        while (nextByte() >= 0) {}
+    }
+    
+    // Читає до capacity байтів тіла в buffer ще до розбору, тож хеш і
+    // довжина відомі заздалегідь; далі read() спершу віддає прочитане.
+    // true — тіло вмістилось повністю
+    bool prefetch(char* buffer, size_t capacity) {
+        size_t count = 0;
+        while (count < capacity) {
+            int c = nextByte();
+            if (c < 0) break;
+            buffer[count++] = (char)c;
+        }
+        buffered = buffer;
+        bufferedLength = count;
+        bufferedPosition = 0;
+        return finished;
+    }
+    
+    unsigned long getBytesRead() const { return bytesRead; }
+    
+    // FNV-1a від усіх прочитаних байтів тіла
+    uint32_t getContentHash() const { return contentHash; }
+    
+    // Такти, проведені в очікуванні байтів від сокета
+    uint32_t getWaitCycles() const { return waitCycles; }
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include "constants.h"
+#include "spsc_ring.h"
+#include "modules/scheduler.h"
+
+// ============================================================================
+// InputEvents - Натискання кнопок через переривання GPIO
+// ============================================================================
+struct InputEvent {
+    uint8_t source;
+    unsigned long timestampMs;
+    uint32_t timestampUs; // esp_timer, спільний для обох ядер
+};
+
+class InputEvents {
+public:
+    enum Source : uint8_t {
+        BADGE_BUTTON_1,
+        BADGE_BUTTON_2,
+        BADGE_BUTTON_3,
+        LEADERBOARD_BUTTON,
+        RFID_CARD,
+        SOURCE_COUNT
+    };
+    
+private:
+    static SpscRing<InputEvent, Input::EVENT_QUEUE_LENGTH> events;
+    static int pins[SOURCE_COUNT];
+    static volatile unsigned long lastPressTime[SOURCE_COUNT];
+    static volatile unsigned long lastReleaseTime[SOURCE_COUNT];
+    static volatile unsigned long droppedEvents;
+    static volatile unsigned long coalescedEvents;
+    static size_t peakPendingEvents; // пише лише споживач
+    static volatile uint8_t awaitedLevels[SOURCE_COUNT];
+    
+    // Брязкіт контактів відсіюється за мітками часу: натискання
+    // приймається, лише якщо кнопка перед цим була відпущена досить
+    // довго і з попереднього натискання минув інтервал дебаунсу
+    static bool IRAM_ATTR acceptPress(uint8_t source, unsigned long now) {
+        if (now - lastReleaseTime[source] < Timing::BUTTON_SETTLE_MS ||
+            now - lastPressTime[source] < Timing::BUTTON_DEBOUNCE_MS) {
+            coalescedEvents++;
+            return false;
+        }
+        
+        lastPressTime[source] = now;
+        return true;
+    }
+    
+    static void IRAM_ATTR pushEvent(uint8_t source, unsigned long now) {
+        InputEvent event;
+        event.source = source;
+        event.timestampMs = now;
+        event.timestampUs = (uint32_t)esp_timer_get_time();
+        if (!events.push(event)) {
+            droppedEvents++;
+        }
+    }
+    
+    // Переривання за рівнем, бо фронт не будить чип з light sleep. Кожне
+    // спрацювання перемикає лінію на протилежний рівень, тож низький
+    // рівень — це натискання (чи IRQ зчитувача), високий — відпускання.
+    // Усі GPIO-переривання обслуговуються одним ядром і не вкладаються
+    // одне в одне, тож для кільця це єдиний виробник
+    static void IRAM_ATTR onLevel(void* arg) {
+        uint8_t source = (uint8_t)(uintptr_t)arg;
+        unsigned long now = millis();
+        bool pressed = awaitedLevels[source] == LOW;
+        awaitedLevels[source] = pressed ? HIGH : LOW;
+        gpio_wakeup_enable((gpio_num_t)pins[source], pressed ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+        
+        if (!pressed) {
+            lastReleaseTime[source] = now;
+            return;
+        }
+        // IRQ зчитувача не брязкотить, тож подія йде в кільце одразу
+        if (source != RFID_CARD && !acceptPress(source, now)) return;
+        
+        pushEvent(source, now);
+        Scheduler::notifyFromIsr();
+    }
+    
+    static void attachLine(int pin, Source source) {
+        pins[source] = pin;
+        awaitedLevels[source] = LOW;
+        attachInterruptArg(digitalPinToInterrupt(pin), onLevel, (void*)(uintptr_t)source, ONLOW_WE);
+    }
+    
+public:
+    static void attach(int pin, Source source) {
+        lastPressTime[source] = millis() - Timing::BUTTON_DEBOUNCE_MS;
+        lastReleaseTime[source] = millis() - Timing::BUTTON_SETTLE_MS;
+        
+        pinMode(pin, INPUT_PULLUP);
+        attachLine(pin, source);
+    }
+    
+    // Лінію IRQ веде сам зчитувач (push-pull), підтяжка не потрібна
+    static void attachIrq(int pin, Source source) {
+        pinMode(pin, INPUT);
+        attachLine(pin, source);
+    }
+    
+    // Мітка найстаршої непрочитаної події без її вилучення
+    static bool peekTimestamp(uint32_t& timestampUs) {
+        InputEvent event;
+        if (!events.peek(event)) return false;
+        
+        timestampUs = event.timestampUs;
+        return true;
+    }
+    
+    // Ніколи не блокує: повертає false, якщо подій немає
+    static bool poll(InputEvent& event) {
+        size_t pending = events.size();
+        if (pending > peakPendingEvents) peakPendingEvents = pending;
+        return events.pop(event);
+    }
+    
+    static size_t getPendingEvents() { return events.size(); }
+    static unsigned long getDroppedEvents() { return droppedEvents; }
+    static unsigned long getCoalescedEvents() { return coalescedEvents; }
+    static size_t getPeakPendingEvents() { return peakPendingEvents; }
+};
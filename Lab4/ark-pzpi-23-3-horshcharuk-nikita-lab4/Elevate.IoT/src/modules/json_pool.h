@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "constants.h"
+
+// ============================================================================
+// JsonPool - Фіксований буфер пам'яті для розбору JSON-відповідей
+// ============================================================================
+// Лінійний алокатор: JsonDocument бере пам'ять зі статичного масиву,
+// а reset() перед кожним розбором звільняє все одразу. Купа не
+// використовується, тому довгий аптайм її не фрагментує
+class JsonPool : public ArduinoJson::Allocator {
+private:
+    static const size_t ALIGNMENT = 8;
+    static const size_t HEADER_SIZE = ALIGNMENT;
+    
+    alignas(8) uint8_t arena[Parsing::JSON_POOL_SIZE];
+    size_t used;
+    size_t peak;
+    uint8_t* lastBlock;
+    
+    static size_t align(size_t size) {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+    
+    static size_t blockSize(void* ptr) {
+        return *reinterpret_cast<size_t*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE);
+    }
+    
+public:
+    JsonPool() : used(0), peak(0), lastBlock(nullptr) {}
+    
+    void* allocate(size_t size) override {
+        size_t total = HEADER_SIZE + align(size);
+        if (used + total > sizeof(arena)) return nullptr;
+        
+        uint8_t* block = arena + used;
+        *reinterpret_cast<size_t*>(block) = size;
+        used += total;
+        if (used > peak) peak = used;
+        
+        lastBlock = block + HEADER_SIZE;
+        return lastBlock;
+    }
+    
+    void deallocate(void* ptr) override {
+        // Повертаємо місце лише для останнього блоку, решту звільнить reset()
+        if (ptr != nullptr && ptr == lastBlock) {
+            used -= HEADER_SIZE + align(blockSize(ptr));
+            lastBlock = nullptr;
+        }
+    }
+    
+    void* reallocate(void* ptr, size_t newSize) override {
+        if (ptr == nullptr) return allocate(newSize);
+        
+        size_t oldSize = blockSize(ptr);
+        if (ptr == lastBlock) {
+            size_t newUsed = used - align(oldSize) + align(newSize);
+            if (newUsed > sizeof(arena)) return nullptr;
+            
+            *reinterpret_cast<size_t*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE) = newSize;
+            used = newUsed;
+            if (used > peak) peak = used;
+            return ptr;
+        }
+        
+        if (newSize <= oldSize) return ptr;
+        
+        void* moved = allocate(newSize);
+        if (moved != nullptr) {
+            memcpy(moved, ptr, min(oldSize, newSize));
+        }
+        return moved;
+    }
+    
+    void reset() {
+        used = 0;
+        lastBlock = nullptr;
+    }
+    
+    size_t getUsed() const { return used; }
+    size_t getPeak() const { return peak; }
+    size_t getCapacity() const { return sizeof(arena); }
+};
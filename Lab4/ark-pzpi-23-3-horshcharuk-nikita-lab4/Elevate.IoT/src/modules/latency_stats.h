@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+
+// ============================================================================
+// LatencyStats - Гістограми затримок етапів сканування
+// ============================================================================
+// Кошик i містить значення з [2^i, 2^(i+1)) мкс. Такти ядер не
+// синхронізовані, тож етапи між задачами міряються часом esp_timer
+class LatencyStats {
+public:
+    enum Stage : uint8_t {
+        INPUT_STAGE,    // переривання -> мережева задача взяла запит
+        CONNECT_STAGE,  // DNS + TCP-з'єднання
+        TTFB_STAGE,     // відправка запиту -> заголовки відповіді
+        BODY_STAGE,     // очікування байтів тіла з сокета
+        PARSE_STAGE,    // розбір без очікування сокета
+        RENDER_STAGE,   // кадр екрана повністю
+        FLUSH_STAGE,    // передача пікселів по SPI всередині кадру
+        SCAN_STAGE,     // переривання -> результат на екрані
+        WAKE_STAGE,     // пробудження з light sleep -> мережева задача взяла запит
+        STAGE_COUNT
+    };
+    
+private:
+    struct Histogram {
+        uint32_t buckets[Latency::BUCKET_COUNT];
+        uint32_t count;
+        uint64_t totalMicros;
+        uint32_t maxMicros;
+    };
+    
+    static Histogram histograms[STAGE_COUNT];
+    static uint32_t cyclesPerMicro;
+    static uint32_t overheadCycles;
+    static bool enabled;
+    
+    static int getBucket(uint32_t value) {
+        int bucket = value > 0 ? 31 - __builtin_clz(value) : 0;
+        return min(bucket, Latency::BUCKET_COUNT - 1);
+    }
+    
+public:
+    // Заміряє вартість одного record() і вимикає збір, якщо вона
+    // перевищує бюджет
+    static void calibrate() {
+        cyclesPerMicro = ESP.getCpuFreqMHz();
+        enabled = true;
+        
+        Histogram saved = histograms[INPUT_STAGE];
+        uint32_t start = now();
+        for (int i = 0; i < Latency::CALIBRATION_ROUNDS; i++) {
+            record(INPUT_STAGE, now());
+        }
+        overheadCycles = (now() - start) / Latency::CALIBRATION_ROUNDS;
+        histograms[INPUT_STAGE] = saved;
+        
+        enabled = overheadCycles <= Latency::OVERHEAD_BUDGET_CYCLES;
+    }
+    
+    static uint32_t now() { return ESP.getCycleCount(); }
+    
+    static uint32_t nowMicros() { return (uint32_t)esp_timer_get_time(); }
+    
+    static void recordMicros(Stage stage, uint32_t micros) {
+        if (!enabled) return;
+        
+        Histogram& histogram = histograms[stage];
+        histogram.buckets[getBucket(micros)]++;
+        histogram.count++;
+        histogram.totalMicros += micros;
+        if (micros > histogram.maxMicros) histogram.maxMicros = micros;
+    }
+    
+    static void recordCycles(Stage stage, uint32_t cycles) {
+        recordMicros(stage, cycles / cyclesPerMicro);
+    }
+    
+    // Етап від startCycles до цього моменту в тій самій задачі
+    static void record(Stage stage, uint32_t startCycles) {
+        recordCycles(stage, now() - startCycles);
+    }
+    
+    // Етап між задачами: startMicros узято з nowMicros()
+    static void recordSince(Stage stage, uint32_t startMicros) {
+        recordMicros(stage, nowMicros() - startMicros);
+    }
+    
+    // Верхня межа кошика, в який потрапляє заданий перцентиль
+    static uint32_t getPercentileMicros(Stage stage, int percent) {
+        const Histogram& histogram = histograms[stage];
+        if (histogram.count == 0) return 0;
+        
+        uint32_t target = ((uint64_t)histogram.count * percent + 99) / 100;
+        uint32_t seen = 0;
+        for (int i = 0; i < Latency::BUCKET_COUNT; i++) {
+            seen += histogram.buckets[i];
+            if (seen >= target) return (2UL << i) - 1;
+        }
+        return histogram.maxMicros;
+    }
+    
+    static const char* getName(Stage stage) {
+        static const char* names[] = {
+            "input", "connect", "ttfb", "body", "parse", "render", "flush", "scan", "wake"
+        };
+        return names[stage];
+    }
+    
+    static uint32_t getCount(Stage stage) { return histograms[stage].count; }
+    static uint32_t getMaxMicros(Stage stage) { return histograms[stage].maxMicros; }
+    static uint32_t getAverageMicros(Stage stage) {
+        const Histogram& histogram = histograms[stage];
+        return histogram.count > 0 ? (uint32_t)(histogram.totalMicros / histogram.count) : 0;
+    }
+    static uint32_t getOverheadCycles() { return overheadCycles; }
+    static uint32_t getOverheadNanos() {
+        return cyclesPerMicro > 0 ? overheadCycles * 1000 / cyclesPerMicro : 0;
+    }
+    static bool isEnabled() { return enabled; }
+    
+    // Машиночитаний дамп, один рядок на етап:
+    //   [latency] stage=parse n=12 avg=850 max=2100 buckets=0,0,...
+    static void dump() {
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            const Histogram& histogram = histograms[i];
+            Serial.printf("[latency] stage=%s n=%lu avg=%lu max=%lu buckets=",
+                          getName((Stage)i),
+                          (unsigned long)histogram.count,
+                          (unsigned long)getAverageMicros((Stage)i),
+                          (unsigned long)histogram.maxMicros);
+            for (int bucket = 0; bucket < Latency::BUCKET_COUNT; bucket++) {
+                Serial.printf(bucket == 0 ? "%lu" : ",%lu", (unsigned long)histogram.buckets[bucket]);
+            }
+            Serial.println();
+        }
+        Serial.printf("[latency] overhead.cycles=%lu overhead.ns=%lu enabled=%d\n",
+                      (unsigned long)overheadCycles,
+                      (unsigned long)getOverheadNanos(),
+                      enabled ? 1 : 0);
+    }
+};
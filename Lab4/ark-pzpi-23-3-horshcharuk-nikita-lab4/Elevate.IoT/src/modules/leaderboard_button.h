@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include "constants.h"
+#include "modules/input_events.h"
 
 // ============================================================================
 // LeaderboardButton - Обробка кнопки лідерборду
@@ -9,46 +10,16 @@
 class LeaderboardButton {
 private:
     static bool isInitialized;
-    static unsigned long lastButtonPressTime;
-    static bool wasPressed;
     
 public:
     static void initialize() {
         if (isInitialized) return;
         
-        pinMode(Hardware::BUTTON_LEADERBOARD, INPUT_PULLUP);
-        lastButtonPressTime = 0;
-        wasPressed = false;
+        InputEvents::attach(Hardware::BUTTON_LEADERBOARD, InputEvents::LEADERBOARD_BUTTON);
         isInitialized = true;
     }
     
-    static bool isPressed() {
-        if (!isInitialized) initialize();
-        
-        unsigned long now = millis();
-        if (now - lastButtonPressTime < Timing::BUTTON_DEBOUNCE_MS) {
-            return false;
-        }
-        
-        if (digitalRead(Hardware::BUTTON_LEADERBOARD) == LOW) {
-            if (!wasPressed) {
-                delay(Timing::BUTTON_PRESS_CHECK_DELAY_MS);
-                if (digitalRead(Hardware::BUTTON_LEADERBOARD) == LOW) {
-                    lastButtonPressTime = now;
-                    wasPressed = true;
-                    
-                    while (digitalRead(Hardware::BUTTON_LEADERBOARD) == LOW) {
-                        delay(10);
-                    }
-                    
-                    return true;
-                }
-            }
-        } else {
-            wasPressed = false;
-        }
-        
-        return false;
+    static bool isPressed(const InputEvent& event) {
+        return event.source == InputEvents::LEADERBOARD_BUTTON;
     }
 };
-
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <HTTPClient.h>
+#include "constants.h"
+#include "types.h"
+#include "fixed_string.h"
+#include "modules/config_manager.h"
+#include "modules/wifi_manager.h"
+#include "modules/api_client.h"
+#include "modules/dashboard_poller.h"
+#include "modules/http_body_stream.h"
+
+// ============================================================================
+// LeaderboardStream - Оновлення лідерборду через Server-Sent Events
+// ============================================================================
+// Окреме довге з'єднання, яке мережева задача обслуговує між запитами.
+// Формат подій:
+//   event: snapshot / data: [{...}, ...]  — уся таблиця
+//   event: entry    / data: {"rank":2,...} — один рядок
+//   рядки ":" без події — heartbeat
+// Поки потік не підключений, дашборд працює на опитуванні
+class LeaderboardStream {
+private:
+    static HTTPClient http;
+    static WiFiClient client;
+    static HttpBodyStream body;
+    static volatile bool connected;
+    static unsigned long nextAttempt;
+    static unsigned long retryMs;
+    static bool unsupported;
+    static unsigned long lastActivity;
+    static FixedString<Parsing::URL_LENGTH> url;
+    static FixedString<Parsing::STREAM_EVENT_LENGTH> eventName;
+    static FixedString<Parsing::STREAM_DATA_LENGTH> line;
+    static FixedString<Parsing::STREAM_DATA_LENGTH> data;
+    static LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+    static unsigned long connects;
+    static unsigned long drops;
+    static unsigned long events;
+    static unsigned long changedRows;
+    
+    static const char* buildStreamUrl() {
+        url.format("%s/api/iot/leaderboard/stream?deviceKey=%s",
+                   ConfigManager::API_BASE_URL, ConfigManager::DEVICE_KEY);
+        return url.c_str();
+    }
+    
+    static bool isWanted() {
+        return ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE &&
+               ConfigManager::updateMode == ConfigManager::STREAM_UPDATES;
+    }
+    
+    static void scheduleRetry() {
+        nextAttempt = millis() + DashboardPoller::withJitter(retryMs);
+        retryMs = min(retryMs * 2, Timing::DASHBOARD_MAX_INTERVAL_MS);
+    }
+    
+    static bool isUnsupportedStatus(int httpCode) {
+        return httpCode == HTTP_CODE_NOT_FOUND || httpCode == HTTP_CODE_METHOD_NOT_ALLOWED ||
+               httpCode == HTTP_CODE_NOT_IMPLEMENTED;
+    }
+    
+    static void connect() {
+        http.setReuse(false);
+        http.begin(client, buildStreamUrl());
+        http.setTimeout(Timing::HTTP_TIMEOUT_MS);
+        http.addHeader("Accept", "text/event-stream");
+        static const char* headerKeys[] = { "Transfer-Encoding" };
+        http.collectHeaders(headerKeys, 1);
+        
+        int httpCode = http.GET();
+        if (httpCode != HTTP_CODE_OK) {
+            http.end();
+            if (isUnsupportedStatus(httpCode)) {
+                unsupported = true;
+            } else {
+                scheduleRetry();
+            }
+            return;
+        }
+        
+        retryMs = Timing::STREAM_RETRY_MS;
+        body.reset(http.getSize(), http.header("Transfer-Encoding").equalsIgnoreCase("chunked"));
+        eventName.clear();
+        line.clear();
+        data.clear();
+        
+        // Дельти накладаються на останню отриману опитуванням таблицю
+        const LeaderboardEntry* cached = ApiClient::getCachedLeaderboard();
+        for (int i = 0; i < Display::MAX_LEADERBOARD_ENTRIES; i++) {
+            entries[i] = cached[i];
+        }
+        lastActivity = millis();
+        connected = true;
+        connects++;
+    }
+    
+    static void disconnect() {
+        http.end();
+        client.stop();
+        connected = false;
+        drops++;
+        scheduleRetry();
+    }
+    
+    // Повертає true, якщо подія змінила хоча б один рядок
+    static bool dispatchEvent() {
+        bool updated = false;
+        if (!data.isEmpty() && !data.isTruncated() &&
+            (eventName.isEmpty() || eventName == "entry" || eventName == "snapshot")) {
+            events++;
+            int changed = ApiClient::applyLeaderboardUpdate(data.c_str(), data.length(),
+                                                            entries, Display::MAX_LEADERBOARD_ENTRIES);
+            if (changed > 0) {
+                changedRows += changed;
+                updated = true;
+            }
+        }
+        
+        eventName.clear();
+        data.clear();
+        return updated;
+    }
+    
+    static bool processLine() {
+        bool updated = false;
+        const char* text = line.c_str();
+        
+        if (line.isEmpty()) {
+            updated = dispatchEvent();
+        } else if (strncmp(text, "event:", 6) == 0) {
+            eventName.assign(text[6] == ' ' ? text + 7 : text + 6);
+        } else if (strncmp(text, "data:", 5) == 0) {
+            if (line.isTruncated()) {
+                data.assign(text, 0); // позначає подію обрізаною, її буде пропущено
+            } else {
+                if (!data.isEmpty()) data.append("\n");
+                data.append(text[5] == ' ' ? text + 6 : text + 5);
+            }
+        }
+        
+        line.clear();
+        return updated;
+    }
+    
+public:
+    // Викликається мережевою задачею між запитами; не чекає на дані.
+    // Повертає true, якщо таблиця змінилась і її треба показати
+    static bool service() {
+        if (!isWanted()) {
+            if (connected) disconnect();
+            return false;
+        }
+        
+        if (!connected) {
+            if (!unsupported && WiFiManager::isConnected() && (long)(millis() - nextAttempt) >= 0) {
+                connect();
+            }
+            return false;
+        }
+        
+        bool updated = false;
+        while (body.available() > 0) {
+            int c = body.read();
+            if (c < 0) break;
+            
+            lastActivity = millis();
+            if (c == '\n') {
+                if (processLine()) updated = true;
+            } else if (c != '\r') {
+                char ch[2] = { (char)c, '\0' };
+                line.append(ch);
+            }
+        }
+        
+        if (!client.connected() || millis() - lastActivity > Timing::STREAM_IDLE_TIMEOUT_MS) {
+            disconnect();
+        }
+        return updated;
+    }
+    
+    // Потік до старого бекенду закривається, новий відкривається без паузи
+    static void reset() {
+        if (connected) disconnect();
+        unsupported = false;
+        retryMs = Timing::STREAM_RETRY_MS;
+        nextAttempt = millis();
+    }
+    
+    static bool isActive() { return isWanted() && !unsupported; }
+    static bool isUnsupported() { return unsupported; }
+    static unsigned long getRetryMs() { return retryMs; }
+    static bool isConnected() { return connected; }
+    static const LeaderboardEntry* getEntries() { return entries; }
+    static unsigned long getConnects() { return connects; }
+    static unsigned long getDrops() { return drops; }
+    static unsigned long getEvents() { return events; }
+    static unsigned long getChangedRows() { return changedRows; }
+};
@@ -5,16 +5,25 @@
 #include "display.h"
 #include "modules/config_manager.h"
 #include "modules/wifi_manager.h"
+#include "modules/dashboard_poller.h"
+#include "modules/retained_screen.h"
+#include "modules/scan_journal.h"
+#include "modules/latency_stats.h"
 
 // ============================================================================
 // LedDisplay - Модуль відображення
 // ============================================================================
 class LedDisplay {
+public:
+    enum ApiState : uint8_t { API_UNKNOWN, API_OK, API_FAIL };
+    
 private:
     static bool isDisplayInitialized;
     static unsigned long startTime;
     static int successfulScans;
     static int failedScans;
+    static int loadingBarWidth;
+    static ApiState apiState;
     
     static void initDisplay() {
         if (isDisplayInitialized) return;
@@ -25,8 +34,52 @@ private:
         isDisplayInitialized = true;
     }
     
-    static String truncateString(const String& str, int maxLen) {
-        return (str.length() > maxLen) ? str.substring(0, maxLen) + "..." : str;
+    typedef FixedString<Display::MAX_LINE_LENGTH> LineText;
+    
+    // Обрізаний рядок збирається на стеку, без String у купі
+    static LineText truncateString(const char* str, int maxLen, bool cut = false) {
+        LineText line;
+        line.assign(str, maxLen);
+        if (cut || line.isTruncated()) {
+            line.append("...");
+        }
+        return line;
+    }
+    
+    template <size_t N>
+    static LineText truncateString(const FixedString<N>& str, int maxLen) {
+        return truncateString(str.c_str(), maxLen, str.isTruncated());
+    }
+    
+    // Вміщує текст разом із "..." у задану ширину рядка
+    static LineText fitString(const char* str, int width) {
+        return truncateString(str, (int)strlen(str) > width ? width - 3 : width);
+    }
+    
+    static LineText formatIp(const char* prefix, const IPAddress& ip, const char* suffix) {
+        LineText line;
+        line.format("%s%u.%u.%u.%u%s", prefix, ip[0], ip[1], ip[2], ip[3], suffix);
+        return line;
+    }
+    
+    // Підвал дашборда внизу табло та екрана офлайну — тих екранів, що
+    // дашборд показує: інтервал опитування, частота запитів і вік таблиці
+    static void drawPollFooter(int slot) {
+        LineText line;
+        if (ConfigManager::currentMode == ConfigManager::DASHBOARD_MODE) {
+            unsigned long rate = DashboardPoller::getRequestRateTenths();
+            line.format("Poll: %lu.%lus | %lu.%lu/min | Age: ",
+                        DashboardPoller::getIntervalMs() / 1000, DashboardPoller::getIntervalMs() % 1000 / 100,
+                        rate / 10, rate % 10);
+            LineText age;
+            if (DashboardPoller::hasFreshData()) {
+                age.format("%lus", DashboardPoller::getStalenessMs() / 1000);
+            } else {
+                age = "--";
+            }
+            line.append(age.c_str());
+        }
+        RetainedScreen::drawText(slot, 10, Display::FOOTER_Y, 1, ILI9341_CYAN, line.c_str());
     }
     
 public:
@@ -34,64 +87,54 @@ public:
         isDisplayInitialized = state;
     }
     
-    static void showUserProfile(const ScanResult& result) {
+    // note позначає попередній профіль із кешу, поки сервер не відповів
+    static void showUserProfile(const ScanResult& result, const char* note = nullptr) {
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_WHITE);
-            display.setTextSize(2);
-            display.setCursor(10, 10);
-            display.println("PROFILE");
+            RetainedScreen::beginFrame(RetainedScreen::PROFILE_SCREEN);
+            RetainedScreen::drawText(0, 10, 10, 2, ILI9341_WHITE, "PROFILE");
+            RetainedScreen::drawText(1, 10, 40, 1, ILI9341_WHITE,
+                                     truncateString(result.fullName, Display::MAX_NAME_LENGTH).c_str());
             
-            display.setTextSize(1);
-            display.setCursor(10, 40);
-            display.println(truncateString(result.fullName, Display::MAX_NAME_LENGTH));
+            LineText line;
+            line.format("Points: %d", result.teamPoints);
+            RetainedScreen::drawText(2, 10, 60, 1, ILI9341_WHITE, line.c_str());
             
-            display.setCursor(10, 60);
-            display.print("Points: ");
-            display.println(result.teamPoints);
-            
-            display.setCursor(10, 80);
-            display.print("Level: ");
-            display.println(truncateString(result.teamLevelName, Display::MAX_LEVEL_LENGTH));
+            line.format("Level: %s", truncateString(result.teamLevelName, Display::MAX_LEVEL_LENGTH).c_str());
+            RetainedScreen::drawText(3, 10, 80, 1, ILI9341_WHITE, line.c_str());
             
+            line.clear();
             if (result.badgeCount > 0) {
-                display.setCursor(10, 100);
-                display.print("Badge: ");
-                display.println(truncateString(result.recentBadges[0], Display::MAX_BADGE_LENGTH));
+                line.format("Badge: %s", truncateString(result.recentBadges[0], Display::MAX_BADGE_LENGTH).c_str());
             }
+            RetainedScreen::drawText(4, 10, 100, 1, ILI9341_WHITE, line.c_str());
+            RetainedScreen::drawText(5, 10, 120, 1, ILI9341_YELLOW, note != nullptr ? note : "");
+            RetainedScreen::endFrame();
         }
     }
     
-    static void showError(const String& message) {
+    static void showError(const char* message) {
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_RED);
-            display.setCursor(10, 10);
-            display.setTextSize(2);
-            display.println("ERROR");
-            
-            display.setTextColor(ILI9341_WHITE);
-            display.setTextSize(1);
+            RetainedScreen::beginFrame(RetainedScreen::ERROR_SCREEN);
+            RetainedScreen::drawText(0, 10, 10, 2, ILI9341_RED, "ERROR");
             
-            String errorMsg = message;
+            const char* rest = message;
+            int slot = 1;
             int yPos = 40;
+            LineText line;
             
-            while (errorMsg.length() > 0 && yPos < 220) {
-                String line = errorMsg;
-                if (line.length() > Display::MAX_ERROR_LINE_LENGTH) {
-                    line = line.substring(0, Display::MAX_ERROR_LINE_LENGTH);
-                    errorMsg = errorMsg.substring(Display::MAX_ERROR_LINE_LENGTH);
-                } else {
-                    errorMsg = "";
-                }
-                display.setCursor(10, yPos);
-                display.println(line);
+            // Порожні рядки стирають хвіст попереднього довшого повідомлення
+            while (yPos < 220) {
+                line.assign(rest, Display::MAX_ERROR_LINE_LENGTH);
+                RetainedScreen::drawText(slot, 10, yPos, 1, ILI9341_WHITE, line.c_str());
+                rest += line.length();
+                slot++;
                 yPos += 20;
             }
+            RetainedScreen::endFrame();
         }
     }
     
@@ -99,38 +142,60 @@ public:
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_WHITE);
-            display.setCursor(10, 10);
-            display.setTextSize(2);
-            display.println("LEADERBOARD");
+            RetainedScreen::beginFrame(RetainedScreen::LEADERBOARD_SCREEN);
+            RetainedScreen::drawText(0, 10, 10, 2, ILI9341_WHITE, "LEADERBOARD");
             
-            display.setTextSize(1);
             int yPos = 40;
             int validEntries = 0;
+            LineText line;
             
             for (int i = 0; i < count && validEntries < Display::MAX_LEADERBOARD_ENTRIES; i++) {
                 if (entries[i].userId > 0 && entries[i].teamPoints > 0) {
-                    display.setCursor(10, yPos);
-                    display.print(entries[i].rank);
-                    display.print(". ");
-                    display.print(truncateString(entries[i].fullName, Display::MAX_LEADERBOARD_NAME_LENGTH));
-                    display.print(" ");
-                    display.print(entries[i].teamPoints);
-                    display.println("pt");
+                    line.format("%d. %s %dpt", entries[i].rank,
+                                truncateString(entries[i].fullName, Display::MAX_LEADERBOARD_NAME_LENGTH).c_str(),
+                                entries[i].teamPoints);
+                    RetainedScreen::drawText(validEntries + 1, 10, yPos, 1, ILI9341_WHITE, line.c_str());
                     yPos += 20;
                     validEntries++;
                 }
             }
             
             while (validEntries < Display::MAX_LEADERBOARD_ENTRIES) {
-                display.setCursor(10, yPos);
-                display.print(validEntries + 1);
-                display.print(". ");
-                display.println("---");
+                line.format("%d. ---", validEntries + 1);
+                RetainedScreen::drawText(validEntries + 1, 10, yPos, 1, ILI9341_WHITE, line.c_str());
                 yPos += 20;
                 validEntries++;
             }
+            drawPollFooter(Display::MAX_LEADERBOARD_ENTRIES + 1);
+            RetainedScreen::endFrame();
+        }
+    }
+    
+    static void showScanning(int userId) {
+        initDisplay();
+        
+        if (isDisplayInitialized) {
+            RetainedScreen::beginFrame(RetainedScreen::SCANNING_SCREEN);
+            RetainedScreen::drawText(0, 10, 80, 2, ILI9341_WHITE, "Scanning...");
+            
+            LineText line;
+            line.format("User ID %d", userId);
+            RetainedScreen::drawText(1, 10, 110, 1, ILI9341_WHITE, line.c_str());
+            RetainedScreen::endFrame();
+        }
+    }
+    
+    static void showScanningCard(const char* uid) {
+        initDisplay();
+        
+        if (isDisplayInitialized) {
+            RetainedScreen::beginFrame(RetainedScreen::SCANNING_SCREEN);
+            RetainedScreen::drawText(0, 10, 80, 2, ILI9341_WHITE, "Scanning...");
+            
+            LineText line;
+            line.format("Card %s", uid);
+            RetainedScreen::drawText(1, 10, 110, 1, ILI9341_WHITE, line.c_str());
+            RetainedScreen::endFrame();
         }
     }
     
@@ -138,29 +203,20 @@ public:
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_WHITE);
-            display.setCursor(10, 80);
-            display.setTextSize(2);
-            display.println("Waiting");
-            display.setCursor(10, 110);
-            display.setTextSize(1);
-            display.println("for scan...");
+            RetainedScreen::beginFrame(RetainedScreen::WAITING_SCREEN);
+            RetainedScreen::drawText(0, 10, 80, 2, ILI9341_WHITE, "Waiting");
+            RetainedScreen::drawText(1, 10, 110, 1, ILI9341_WHITE, "for scan...");
+            RetainedScreen::endFrame();
         }
     }
     
-    static void showLoadingStep(const String& step, int progress = -1) {
+    static void showLoadingStep(const char* step, int progress = -1) {
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_WHITE);
-            display.setCursor(10, 50);
-            display.setTextSize(2);
-            display.println("Elevate");
-            display.setCursor(10, 80);
-            display.setTextSize(1);
-            display.println(step);
+            bool cleared = RetainedScreen::beginFrame(RetainedScreen::LOADING_SCREEN);
+            RetainedScreen::drawText(0, 10, 50, 2, ILI9341_WHITE, "Elevate");
+            RetainedScreen::drawText(1, 10, 80, 1, ILI9341_WHITE, step);
             
             if (progress >= 0 && progress <= 100) {
                 constexpr int barWidth = 200;
@@ -168,14 +224,22 @@ public:
                 constexpr int barX = 20;
                 constexpr int barY = 120;
                 
-                display.drawRect(barX, barY, barWidth, barHeight, ILI9341_WHITE);
+                // Смуга лише росте, тому домальовується тільки приріст
                 int fillWidth = (barWidth * progress) / 100;
-                display.fillRect(barX, barY, fillWidth, barHeight, ILI9341_GREEN);
+                if (cleared || fillWidth < loadingBarWidth) {
+                    RetainedScreen::fillRect(barX, barY, barWidth, barHeight, ILI9341_BLACK);
+                    RetainedScreen::drawRect(barX, barY, barWidth, barHeight, ILI9341_WHITE);
+                    loadingBarWidth = 0;
+                }
+                RetainedScreen::fillRect(barX + loadingBarWidth, barY, fillWidth - loadingBarWidth,
+                                         barHeight, ILI9341_GREEN);
+                loadingBarWidth = fillWidth;
                 
-                display.setCursor(barX + barWidth + 10, barY - 2);
-                display.print(progress);
-                display.print("%");
+                LineText line;
+                line.format("%d%%", progress);
+                RetainedScreen::drawText(2, barX + barWidth + 10, barY - 2, 1, ILI9341_WHITE, line.c_str());
             }
+            RetainedScreen::endFrame();
         }
     }
     
@@ -183,59 +247,67 @@ public:
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_WHITE);
-            
-            display.setCursor(10, 10);
-            display.setTextSize(1);
-            display.println("SERVER UNAVAILABLE");
+            RetainedScreen::beginFrame(RetainedScreen::OFFLINE_SCREEN);
+            RetainedScreen::drawText(0, 10, 10, 1, ILI9341_WHITE, "SERVER UNAVAILABLE");
             
-            display.setCursor(10, 30);
-            display.print("Wi-Fi: ");
+            LineText line;
             if (WiFiManager::isConnected()) {
-                display.println("OK");
-                display.setCursor(10, 50);
-                display.print("IP: ");
-                IPAddress ip = WiFi.localIP();
-                display.println(String(ip[0]) + "." + String(ip[1]) + "." + 
-                               String(ip[2]) + "." + String(ip[3]));
+                RetainedScreen::drawText(1, 10, 30, 1, ILI9341_WHITE, "Wi-Fi: OK");
+                line = formatIp("IP: ", WiFi.localIP(), "");
             } else {
-                display.println("NOT CONN.");
+                RetainedScreen::drawText(1, 10, 30, 1, ILI9341_WHITE, "Wi-Fi: NOT CONN.");
+                line.clear();
             }
+            RetainedScreen::drawText(2, 10, 50, 1, ILI9341_WHITE, line.c_str());
             
             unsigned long uptime = (millis() - startTime) / 1000;
             unsigned long hours = uptime / 3600;
             unsigned long minutes = (uptime % 3600) / 60;
             unsigned long seconds = uptime % 60;
             
-            display.setCursor(10, 70);
-            display.print("Time: ");
             if (hours > 0) {
-                display.print(hours);
-                display.print("h ");
-            }
-            if (minutes > 0 || hours > 0) {
-                display.print(minutes);
-                display.print("m");
+                line.format("Time: %luh %lum", hours, minutes);
+            } else if (minutes > 0) {
+                line.format("Time: %lum", minutes);
             } else {
-                display.print(seconds);
-                display.print("s");
+                line.format("Time: %lus", seconds);
             }
+            RetainedScreen::drawText(3, 10, 70, 1, ILI9341_WHITE, line.c_str());
+            
+            line.format("Scans: %d/%d", successfulScans, successfulScans + failedScans);
+            RetainedScreen::drawText(4, 10, 90, 1, ILI9341_WHITE, line.c_str());
             
-            display.setCursor(10, 90);
-            display.print("Scans: ");
-            display.print(successfulScans);
-            display.print("/");
-            display.print(successfulScans + failedScans);
+            line.format("Mode: %s", (ConfigManager::currentMode == ConfigManager::SCAN_MODE) ? "SCAN" : "DASHBOARD");
+            RetainedScreen::drawText(5, 10, 110, 1, ILI9341_WHITE, line.c_str());
             
-            display.setCursor(10, 110);
-            display.print("Mode: ");
-            display.println((ConfigManager::currentMode == ConfigManager::SCAN_MODE) ? "SCAN" : "DASHBOARD");
+            line.format("Queued: %u", (unsigned)ScanJournal::getPendingRecords());
+            RetainedScreen::drawText(6, 10, 130, 1, ILI9341_WHITE, line.c_str());
+            drawPollFooter(7);
+            RetainedScreen::endFrame();
+        }
+    }
+    
+    // Підвал оновлюється після кожного опитування й події потоку, навіть
+    // коли табло те саме і решта екрана не перемальовується
+    static void refreshPollFooter() {
+        if (!isDisplayInitialized) return;
+        
+        RetainedScreen::Screen screen = RetainedScreen::getCurrentScreen();
+        if (screen == RetainedScreen::LEADERBOARD_SCREEN) {
+            RetainedScreen::beginFrame(screen);
+            drawPollFooter(Display::MAX_LEADERBOARD_ENTRIES + 1);
+            RetainedScreen::endFrame();
+        } else if (screen == RetainedScreen::OFFLINE_SCREEN) {
+            RetainedScreen::beginFrame(screen);
+            drawPollFooter(7);
+            RetainedScreen::endFrame();
         }
     }
     
     static void incrementSuccessfulScan() { successfulScans++; }
     static void incrementFailedScan() { failedScans++; }
+    static int getSuccessfulScans() { return successfulScans; }
+    static int getFailedScans() { return failedScans; }
     
     static void initializeStats() {
         startTime = millis();
@@ -243,117 +315,115 @@ public:
         failedScans = 0;
     }
     
-    static bool testApiConnection() {
-        if (!WiFiManager::isConnected()) {
-            return false;
-        }
-        
-        // Швидка перевірка доступності API
-        HTTPClient http;
-        String testUrl = String(ConfigManager::API_BASE_URL) + "/api/iot/leaderboard?deviceKey=" + 
-                        String(ConfigManager::DEVICE_KEY);
-        http.begin(testUrl);
-        http.setTimeout(3000); // Короткий таймаут для швидкої перевірки
-        int httpCode = http.GET();
-        http.end();
+    // Результат перевірки API приходить від мережевої задачі
+    static void setApiReachable(bool reachable) {
+        apiState = reachable ? API_OK : API_FAIL;
+    }
+    
+    // Новий бекенд ще не перевірений
+    static void resetApiState() {
+        apiState = API_UNKNOWN;
+    }
+    
+    // Перцентилі — верхні межі кошиків гістограми
+    static void showDiagnostics() {
+        initDisplay();
         
-        return (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_BAD_REQUEST || httpCode == HTTP_CODE_UNAUTHORIZED);
+        if (isDisplayInitialized) {
+            RetainedScreen::beginFrame(RetainedScreen::DIAGNOSTICS_SCREEN);
+            RetainedScreen::drawText(0, 5, 5, 1, ILI9341_WHITE, "=== LATENCY, us (p50/p99/max) ===");
+            
+            LineText line;
+            int yPos = 25;
+            for (int i = 0; i < LatencyStats::STAGE_COUNT; i++) {
+                LatencyStats::Stage stage = (LatencyStats::Stage)i;
+                line.format("%-8s n=%-5lu %lu/%lu/%lu",
+                            LatencyStats::getName(stage),
+                            (unsigned long)LatencyStats::getCount(stage),
+                            (unsigned long)LatencyStats::getPercentileMicros(stage, 50),
+                            (unsigned long)LatencyStats::getPercentileMicros(stage, 99),
+                            (unsigned long)LatencyStats::getMaxMicros(stage));
+                RetainedScreen::drawText(1 + i, 5, yPos, 1, ILI9341_WHITE, line.c_str());
+                yPos += 18;
+            }
+            
+            line.format("Overhead: %lu cycles (%lu ns) per sample%s",
+                        (unsigned long)LatencyStats::getOverheadCycles(),
+                        (unsigned long)LatencyStats::getOverheadNanos(),
+                        LatencyStats::isEnabled() ? "" : ", OFF");
+            RetainedScreen::drawText(1 + LatencyStats::STAGE_COUNT, 5, yPos + 6, 1,
+                                     LatencyStats::isEnabled() ? ILI9341_GREEN : ILI9341_RED, line.c_str());
+            RetainedScreen::endFrame();
+        }
     }
     
     static void showSystemStatus() {
         initDisplay();
         
         if (isDisplayInitialized) {
-            display.fillScreen(ILI9341_BLACK);
-            display.setTextColor(ILI9341_WHITE);
+            RetainedScreen::beginFrame(RetainedScreen::STATUS_SCREEN);
             
             // Заголовок
-            display.setCursor(10, 5);
-            display.setTextSize(1);
-            display.println("=== SYSTEM STATUS ===");
+            RetainedScreen::drawText(0, 10, 5, 1, ILI9341_WHITE, "=== SYSTEM STATUS ===");
             
             int yPos = 25;
             const int lineHeight = 18;
             const int maxLineWidth = 38; // Збільшена ширина для дисплею 320px
+            LineText line;
+            
+            // Рядки підключення беруться з одних застосованих налаштувань;
+            // API_BASE_URL і DEVICE_KEY змінює мережева задача
+            const ConfigManager::Settings& settings = ConfigManager::getStored();
             
             // Wi-Fi SSID
-            display.setTextColor(ILI9341_WHITE);
-            display.setCursor(5, yPos);
-            display.print("WiFi: ");
-            String ssid = String(ConfigManager::WIFI_SSID);
-            if (ssid.length() > maxLineWidth - 7) {
-                ssid = ssid.substring(0, maxLineWidth - 10) + "...";
-            }
-            display.println(ssid);
+            line.format("WiFi: %s", fitString(settings.wifiSsid, maxLineWidth - 7).c_str());
+            RetainedScreen::drawText(1, 5, yPos, 1, ILI9341_WHITE, line.c_str());
             yPos += lineHeight;
             
             // Wi-Fi Status
-            display.setCursor(5, yPos);
-            display.print("WiFi Status: ");
-            bool wifiConnected = WiFiManager::isConnected();
-            if (wifiConnected) {
-                display.setTextColor(ILI9341_GREEN);
-                display.print("OK");
-                display.setTextColor(ILI9341_WHITE);
-                IPAddress ip = WiFi.localIP();
-                display.print(" (");
-                display.print(ip[0]);
-                display.print(".");
-                display.print(ip[1]);
-                display.print(".");
-                display.print(ip[2]);
-                display.print(".");
-                display.print(ip[3]);
-                display.println(")");
+            const char* wifiLabel = "WiFi Status: ";
+            int wifiValueX = 5 + RetainedScreen::textWidth(wifiLabel, 1);
+            RetainedScreen::drawText(2, 5, yPos, 1, ILI9341_WHITE, wifiLabel);
+            if (WiFiManager::isConnected()) {
+                RetainedScreen::drawText(3, wifiValueX, yPos, 1, ILI9341_GREEN, "OK");
+                line = formatIp(" (", WiFi.localIP(), ")");
+                RetainedScreen::drawText(4, wifiValueX + RetainedScreen::textWidth("OK", 1), yPos, 1,
+                                         ILI9341_WHITE, line.c_str());
             } else {
-                display.setTextColor(ILI9341_RED);
-                display.println("DISCONNECTED");
-                display.setTextColor(ILI9341_WHITE);
+                RetainedScreen::drawText(3, wifiValueX, yPos, 1, ILI9341_RED, "DISCONNECTED");
+                RetainedScreen::drawText(4, wifiValueX, yPos, 1, ILI9341_WHITE, "");
             }
             yPos += lineHeight;
             
             // API URL (без переносу)
-            display.setCursor(5, yPos);
-            display.print("API: ");
-            String apiUrl = String(ConfigManager::API_BASE_URL);
-            if (apiUrl.length() > maxLineWidth - 6) {
-                apiUrl = apiUrl.substring(0, maxLineWidth - 9) + "...";
-            }
-            display.println(apiUrl);
+            line.format("API: %s", fitString(settings.apiBaseUrl, maxLineWidth - 6).c_str());
+            RetainedScreen::drawText(5, 5, yPos, 1, ILI9341_WHITE, line.c_str());
             yPos += lineHeight;
             
             // API Status
-            display.setCursor(5, yPos);
-            display.print("API Status: ");
-            bool apiOk = testApiConnection();
-            if (apiOk) {
-                display.setTextColor(ILI9341_GREEN);
-                display.println("OK");
+            const char* apiLabel = "API Status: ";
+            RetainedScreen::drawText(6, 5, yPos, 1, ILI9341_WHITE, apiLabel);
+            int apiValueX = 5 + RetainedScreen::textWidth(apiLabel, 1);
+            if (apiState == API_UNKNOWN) {
+                RetainedScreen::drawText(7, apiValueX, yPos, 1, ILI9341_YELLOW, "...");
             } else {
-                display.setTextColor(ILI9341_RED);
-                display.println("FAIL");
+                bool apiOk = apiState == API_OK;
+                RetainedScreen::drawText(7, apiValueX, yPos, 1,
+                                         apiOk ? ILI9341_GREEN : ILI9341_RED, apiOk ? "OK" : "FAIL");
             }
-            display.setTextColor(ILI9341_WHITE);
             yPos += lineHeight;
             
             // Device Key
-            display.setCursor(5, yPos);
-            display.print("Device: ");
-            String deviceKey = String(ConfigManager::DEVICE_KEY);
-            if (deviceKey.length() > maxLineWidth - 9) {
-                deviceKey = deviceKey.substring(0, maxLineWidth - 12) + "...";
-            }
-            display.println(deviceKey);
+            line.format("Device: %s", fitString(settings.deviceKey, maxLineWidth - 9).c_str());
+            RetainedScreen::drawText(8, 5, yPos, 1, ILI9341_WHITE, line.c_str());
             yPos += lineHeight;
             
             // Mode
-            display.setCursor(5, yPos);
-            display.print("Mode: ");
-            display.print((ConfigManager::currentMode == ConfigManager::SCAN_MODE) ? "SCAN" : "DASH");
-            display.print(" | Int: ");
-            display.print(ConfigManager::dashboardUpdateInterval / 1000);
-            display.println("s");
+            line.format("Mode: %s | Int: %lus",
+                        (ConfigManager::currentMode == ConfigManager::SCAN_MODE) ? "SCAN" : "DASH",
+                        ConfigManager::dashboardUpdateInterval / 1000);
+            RetainedScreen::drawText(9, 5, yPos, 1, ILI9341_WHITE, line.c_str());
+            RetainedScreen::endFrame();
         }
     }
 };
-
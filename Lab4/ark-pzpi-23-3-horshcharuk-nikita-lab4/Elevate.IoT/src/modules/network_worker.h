@@ -0,0 +1,272 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "types.h"
+#include "spsc_ring.h"
+#include "modules/config_manager.h"
+#include "modules/api_client.h"
+#include "modules/scan_journal.h"
+#include "modules/leaderboard_stream.h"
+#include "modules/scheduler.h"
+#include "modules/latency_stats.h"
+#include "modules/core_load.h"
+
+// ============================================================================
+// NetworkWorker - Фонова задача FreeRTOS для HTTP-запитів
+// ============================================================================
+// Задача живе на ядрі 0 разом зі стеком Wi-Fi; сторону, що чекає на
+// SpscRing, будить сповіщення задачі
+class NetworkWorker {
+public:
+    // STREAM_UPDATE не ставиться в чергу: його публікує сама задача
+    enum JobType : uint8_t {
+        SCAN_JOB,
+        LEADERBOARD_JOB,
+        CARD_LOOKUP_JOB,
+        JOURNAL_DRAIN_JOB,
+        PROBE_JOB,
+        CONFIG_JOB,     // userId несе біти ConfigManager::Change
+        STREAM_UPDATE
+    };
+    
+    struct Completion {
+        JobType type;
+        int userId;
+        uint64_t cardKey;
+        int slot;
+        bool success;
+        bool unchanged;
+        unsigned long postedAt;
+        unsigned long latencyMs;
+        uint32_t inputAt;
+    };
+    
+private:
+    struct Job {
+        JobType type;
+        int userId;
+        uint64_t cardKey;
+        unsigned long postedAt;
+        uint32_t inputAt; // мітка переривання, 0 — запит не від натискання
+    };
+    
+    // Черга передає індекс слота; два зайві слоти - для задачі й UI
+    static const int RESULT_SLOTS = Tasks::RESULT_QUEUE_LENGTH + 2;
+    
+    static SpscRing<Job, Tasks::JOB_QUEUE_LENGTH> jobs;
+    static SpscRing<Completion, Tasks::RESULT_QUEUE_LENGTH> results;
+    static TaskHandle_t taskHandle;
+    static ScanResult scanSlots[RESULT_SLOTS];
+    static LeaderboardEntry leaderboardSlots[RESULT_SLOTS][Display::MAX_LEADERBOARD_ENTRIES];
+    static int nextSlot;
+    static volatile bool jobInFlight;
+    static volatile uint32_t wokeAt;
+    static bool streamUpdatePending;
+    static unsigned long droppedJobs;
+    static unsigned long handoffStalls;
+    static int peakQueueDepth;
+    static unsigned long completedJobs;
+    static unsigned long lastLatencyMs;
+    static unsigned long maxLatencyMs;
+    static unsigned long totalLatencyMs;
+    
+    static void runJob(const Job& job, Completion& done) {
+        if (job.inputAt != 0) {
+            LatencyStats::recordSince(LatencyStats::INPUT_STAGE, job.inputAt);
+        }
+        uint32_t woke = wokeAt;
+        if (woke != 0) {
+            wokeAt = 0;
+            LatencyStats::recordSince(LatencyStats::WAKE_STAGE, woke);
+        }
+        
+        done.type = job.type;
+        done.inputAt = job.inputAt;
+        done.userId = job.userId;
+        done.cardKey = job.cardKey;
+        done.unchanged = false;
+        done.slot = nextSlot;
+        nextSlot = (nextSlot + 1) % RESULT_SLOTS;
+        
+        if (job.type == SCAN_JOB) {
+            scanSlots[done.slot] = ApiClient::scanUser(job.userId);
+            done.success = scanSlots[done.slot].success;
+            if (!done.success && isRetryableError(scanSlots[done.slot].error)) {
+                ScanJournal::append(job.userId);
+            }
+        } else if (job.type == JOURNAL_DRAIN_JOB) {
+            done.success = drainJournal(done.userId);
+        } else if (job.type == CARD_LOOKUP_JOB) {
+            done.success = ApiClient::lookupCard(job.cardKey, done.userId);
+        } else if (job.type == PROBE_JOB) {
+            done.success = ApiClient::probeApi();
+        } else if (job.type == CONFIG_JOB) {
+            applyConfig(job.userId);
+            done.success = true;
+        } else {
+            ApiClient::LeaderboardStatus status =
+                ApiClient::getLeaderboard(leaderboardSlots[done.slot], Display::MAX_LEADERBOARD_ENTRIES);
+            done.success = status != ApiClient::LEADERBOARD_FAILED;
+            done.unchanged = status == ApiClient::LEADERBOARD_UNCHANGED;
+        }
+        
+        done.postedAt = job.postedAt;
+        done.latencyMs = millis() - job.postedAt;
+    }
+    
+    // Сокети бекенду й потоку належать цій задачі, тож новий бекенд і
+    // режим оновлень застосовуються тут, між запитами
+    static void applyConfig(uint8_t changes) {
+        if (changes & ConfigManager::BACKEND_CHANGED) {
+            ConfigManager::applyBackend();
+            ApiClient::resetBackend();
+            LeaderboardStream::reset();
+        }
+        // Потік одразу відкривається чи закривається за новим режимом
+        serviceStream();
+    }
+    
+    // Пакет записів іде підряд через один keep-alive сокет. Між записами
+    // перевіряється черга, тож живе сканування чекає не довше за один запит
+    static bool drainJournal(int& sent) {
+        sent = 0;
+        bool delivered = true;
+        JournalRecord record;
+        
+        ScanJournal::beginDrain();
+        while (sent < Journal::DRAIN_BATCH_SIZE && jobs.isEmpty() &&
+               ScanJournal::next(record)) {
+            delivered = ApiClient::replayScan(record.userId);
+            if (!delivered) break;
+            
+            ScanJournal::consume();
+            sent++;
+        }
+        ScanJournal::endDrain();
+        
+        return delivered;
+    }
+    
+    static void serviceStream() {
+        if (LeaderboardStream::service()) streamUpdatePending = true;
+        if (!streamUpdatePending) return;
+        
+        Completion done;
+        done.type = STREAM_UPDATE;
+        done.userId = 0;
+        done.cardKey = 0;
+        done.slot = nextSlot;
+        done.success = true;
+        done.unchanged = false;
+        done.postedAt = millis();
+        done.latencyMs = 0;
+        done.inputAt = 0;
+        
+        const LeaderboardEntry* entries = LeaderboardStream::getEntries();
+        for (int i = 0; i < Display::MAX_LEADERBOARD_ENTRIES; i++) {
+            leaderboardSlots[done.slot][i] = entries[i];
+        }
+        
+        // Якщо UI не встигає, зміни не губляться: спробуємо наступного разу
+        if (results.push(done)) {
+            nextSlot = (nextSlot + 1) % RESULT_SLOTS;
+            streamUpdatePending = false;
+            Scheduler::notify();
+        }
+    }
+    
+    // Якщо UI відстав на все кільце, задача чекає тік і пробує знову
+    static void publish(const Completion& done) {
+        while (!results.push(done)) {
+            handoffStalls++;
+            vTaskDelay(1);
+        }
+        Scheduler::notify();
+    }
+    
+    static void taskLoop(void*) {
+        Job job;
+        Completion done;
+        
+        CoreLoad::attach("network");
+        
+        // Журнал монтується тут, паралельно з ініціалізацією дисплея;
+        // завдання, поставлені раніше, просто чекають у кільці
+        ScanJournal::initialize();
+        
+        for (;;) {
+            if (!jobs.pop(job)) {
+                // Поки відкритий потік лідерборду, задача прокидається між запитами
+                TickType_t wait = LeaderboardStream::isActive() ? pdMS_TO_TICKS(Timing::STREAM_SERVICE_MS)
+                                                                : portMAX_DELAY;
+                if (ulTaskNotifyTake(pdTRUE, wait) == 0) serviceStream();
+                continue;
+            }
+            
+            jobInFlight = true;
+            runJob(job, done);
+            
+            lastLatencyMs = done.latencyMs;
+            if (done.latencyMs > maxLatencyMs) maxLatencyMs = done.latencyMs;
+            totalLatencyMs += done.latencyMs;
+            completedJobs++;
+            
+            publish(done);
+            jobInFlight = false;
+        }
+    }
+    
+public:
+    static void start() {
+        if (taskHandle != nullptr) return;
+        
+        xTaskCreatePinnedToCore(taskLoop, "network", Tasks::NETWORK_STACK_SIZE, nullptr,
+                                Tasks::NETWORK_PRIORITY, &taskHandle, Tasks::NETWORK_CORE);
+    }
+    
+    static bool post(JobType type, int userId = 0, uint64_t cardKey = 0, uint32_t inputAt = 0) {
+        if (taskHandle == nullptr) return false;
+        
+        Job job;
+        job.type = type;
+        job.userId = userId;
+        job.cardKey = cardKey;
+        job.postedAt = millis();
+        job.inputAt = inputAt;
+        
+        if (!jobs.push(job)) {
+            droppedJobs++;
+            return false;
+        }
+        xTaskNotifyGive(taskHandle);
+        
+        int depth = getQueueDepth();
+        if (depth > peakQueueDepth) peakQueueDepth = depth;
+        return true;
+    }
+    
+    static bool pollResult(Completion& done) {
+        return results.pop(done);
+    }
+    
+    // Ставиться, лише поки задача простоює; перший запит пише WAKE_STAGE
+    static void markWake(uint32_t micros) { wokeAt = micros; }
+    
+    static const ScanResult& getScanResult(int slot) { return scanSlots[slot]; }
+    static const LeaderboardEntry* getLeaderboard(int slot) { return leaderboardSlots[slot]; }
+    
+    static int getQueueDepth() {
+        return jobs.size() + (jobInFlight ? 1 : 0);
+    }
+    
+    static unsigned long getDroppedJobs() { return droppedJobs; }
+    static unsigned long getHandoffStalls() { return handoffStalls; }
+    static int getPeakQueueDepth() { return peakQueueDepth; }
+    static unsigned long getCompletedJobs() { return completedJobs; }
+    static unsigned long getLastLatencyMs() { return lastLatencyMs; }
+    static unsigned long getMaxLatencyMs() { return maxLatencyMs; }
+    static unsigned long getAverageLatencyMs() {
+        return completedJobs > 0 ? totalLatencyMs / completedJobs : 0;
+    }
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <driver/uart.h>
+#include "constants.h"
+#include "modules/config_manager.h"
+#include "modules/wifi_manager.h"
+#include "modules/network_worker.h"
+#include "modules/input_events.h"
+#include "modules/badge_reader.h"
+#include "modules/core_logic.h"
+#include "modules/config_console.h"
+#include "modules/scheduler.h"
+
+// ============================================================================
+// PowerManager - Автоматичний light sleep між подіями
+// ============================================================================
+// Потрібні CONFIG_PM_ENABLE і CONFIG_FREERTOS_USE_TICKLESS_IDLE, інакше
+// esp_pm_configure() відмовляє ([status] power.mode=unsupported)
+class PowerManager {
+private:
+    static esp_pm_lock_handle_t noSleepLock;
+    static esp_pm_lock_handle_t cpuMaxLock;
+    static esp_err_t configureResult;
+    static bool configuredSleep;
+    static bool lockHeld;
+    static bool cpuHeld;
+    static bool radioAwake;
+    static bool rfidIdle;
+    static unsigned long lastBusyAt;
+    static unsigned long sleeps;
+    static unsigned long gpioWakeups;
+    static unsigned long timerWakeups;
+    static unsigned long uartWakeups;
+    static uint64_t lightSleptMicros;
+    static unsigned long startedAt;
+    
+    static void configure() {
+        esp_pm_config_esp32_t config = {};
+        config.max_freq_mhz = Power::MAX_CPU_MHZ;
+        config.min_freq_mhz = Power::MIN_CPU_MHZ;
+        config.light_sleep_enable = ConfigManager::lightSleepIdle;
+        configureResult = esp_pm_configure(&config);
+        configuredSleep = ConfigManager::lightSleepIdle;
+    }
+    
+    // Сон додав би до затримки запиту вихід із нього
+    static bool hasWork() {
+        return CoreLogic::getPendingRequests() > 0 || NetworkWorker::getQueueDepth() > 0 ||
+               InputEvents::getPendingEvents() > 0;
+    }
+    
+    static void holdAwake(bool hold) {
+        if (hold == lockHeld) return;
+        
+        lockHeld = hold;
+        if (hold) {
+            esp_pm_lock_acquire(noSleepLock);
+        } else {
+            esp_pm_lock_release(noSleepLock);
+        }
+    }
+    
+    // LatencyStats рахує такти за максимальною частотою
+    static void holdCpu(bool hold) {
+        if (hold == cpuHeld) return;
+        
+        cpuHeld = hold;
+        if (hold) {
+            esp_pm_lock_acquire(cpuMaxLock);
+        } else {
+            esp_pm_lock_release(cpuMaxLock);
+        }
+    }
+    
+    // Без power save точка віддає відповідь одразу, а не після маяка
+    static void holdRadio(bool hold) {
+        if (hold == radioAwake) return;
+        
+        radioAwake = hold;
+        WiFi.setSleep(hold ? WIFI_PS_NONE : WIFI_PS_MAX_MODEM);
+    }
+    
+    // У тривалому простої зчитувач опитується рідше
+    static void setRfidIdle(bool idle) {
+        if (idle == rfidIdle || !Scheduler::isArmed(Scheduler::RFID_TIMER)) return;
+        
+        rfidIdle = idle;
+        Scheduler::every(Scheduler::RFID_TIMER,
+                         idle ? Timing::RFID_IDLE_INTERVAL_MS : Timing::RFID_ACTIVATE_INTERVAL_MS,
+                         BadgeReader::service);
+    }
+    
+    // Мітка події на лінії - це мітка пробудження для WAKE_STAGE
+    static void recordWake(unsigned long slept) {
+        sleeps++;
+        lightSleptMicros += slept;
+        
+        uint32_t wokeAt;
+        if (InputEvents::peekTimestamp(wokeAt)) {
+            gpioWakeups++;
+            lastBusyAt = millis();
+            NetworkWorker::markWake(wokeAt);
+        } else if (Serial.available() > 0) {
+            uartWakeups++;
+            ConfigConsole::markWake();
+        } else {
+            timerWakeups++;
+        }
+    }
+    
+    static uint64_t getUptimeMicros() {
+        return (uint64_t)(millis() - startedAt) * 1000ULL;
+    }
+    
+public:
+    static void begin() {
+        startedAt = millis();
+        lastBusyAt = startedAt;
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "loop", &noSleepLock);
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "measure", &cpuMaxLock);
+        holdCpu(true);
+        configure();
+        
+        // Рівні на лініях InputEvents уже ввімкнені як джерела пробудження
+        esp_sleep_enable_gpio_wakeup();
+        uart_set_wakeup_threshold(UART_NUM_0, Power::UART_WAKE_THRESHOLD);
+        esp_sleep_enable_uart_wakeup(UART_NUM_0);
+    }
+    
+    // Викликається з loop() замість Scheduler::sleep()
+    static void idle() {
+        if (ConfigManager::lightSleepIdle != configuredSleep) configure();
+        
+        // Натискання після попереднього пробудження так і не дало запиту
+        if (CoreLogic::getPendingRequests() == 0) NetworkWorker::markWake(0);
+        
+        bool working = hasWork();
+        bool busy = working || ConfigConsole::isAwake() || !WiFiManager::isConnected();
+        holdRadio(working);
+        holdCpu(working);
+        holdAwake(busy);
+        
+        unsigned long now = millis();
+        if (busy) lastBusyAt = now;
+        setRfidIdle(!busy && now - lastBusyAt >= Power::RFID_IDLE_AFTER_MS);
+        
+        bool canSleep = !busy && configuredSleep && configureResult == ESP_OK &&
+                        Scheduler::getMicrosUntilDeadline() >= Power::LIGHT_SLEEP_MIN_MS * 1000UL;
+        unsigned long start = micros();
+        Scheduler::sleep();
+        
+        holdCpu(true);
+        if (canSleep) recordWake(micros() - start);
+    }
+    
+    static const char* getMode() {
+        if (!configuredSleep) return "off";
+        return configureResult == ESP_OK ? "auto" : "unsupported";
+    }
+    
+    static unsigned long getSleeps() { return sleeps; }
+    static unsigned long getGpioWakeups() { return gpioWakeups; }
+    static unsigned long getTimerWakeups() { return timerWakeups; }
+    static unsigned long getUartWakeups() { return uartWakeups; }
+    
+    // Верхня межа: маяки й мережева задача будять чип і посеред очікування
+    static unsigned long getSleepPercent() {
+        uint64_t uptime = getUptimeMicros();
+        return uptime > 0 ? (unsigned long)(lightSleptMicros * 100 / uptime) : 0;
+    }
+    
+    // Оцінка середнього струму: loop() працює, чекає, чекає зі сном
+    static unsigned long getAverageMicroamps() {
+        uint64_t uptime = getUptimeMicros();
+        if (uptime == 0) return 0;
+        
+        uint64_t waited = Scheduler::getSleptMicros() - lightSleptMicros;
+        uint64_t idle = min(uptime, Scheduler::getSleptMicros());
+        uint64_t active = uptime - idle;
+        uint64_t charge = active * Power::ACTIVE_UA + waited * Power::IDLE_UA +
+                          lightSleptMicros * Power::LIGHT_SLEEP_UA;
+        return (unsigned long)(charge / uptime);
+    }
+    
+    // Те саме лише для простою
+    static unsigned long getIdleMicroamps() {
+        uint64_t idle = Scheduler::getSleptMicros();
+        if (idle == 0) return 0;
+        
+        uint64_t waited = idle - lightSleptMicros;
+        return (unsigned long)((waited * Power::IDLE_UA + lightSleptMicros * Power::LIGHT_SLEEP_UA) / idle);
+    }
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "types.h"
+
+// ============================================================================
+// ProfileCache - LRU-кеш останніх профілів для миттєвого показу
+// ============================================================================
+class ProfileCache {
+private:
+    struct Entry {
+        ScanResult profile;
+        unsigned long lastUsed;
+    };
+    
+    static Entry entries[Profiles::CACHE_SIZE];
+    static unsigned long useCounter;
+    static unsigned long hits;
+    static unsigned long misses;
+    static unsigned long evictions;
+    static uint64_t cachedFirstPixelMicros;
+    static unsigned long cachedSamples;
+    static uint64_t uncachedFirstPixelMicros;
+    static unsigned long uncachedSamples;
+    
+    static Entry* findEntry(int userId) {
+        for (int i = 0; i < Profiles::CACHE_SIZE; i++) {
+            if (entries[i].lastUsed != 0 && entries[i].profile.userId == userId) {
+                return &entries[i];
+            }
+        }
+        return nullptr;
+    }
+    
+    // Порожній слот або той, що найдовше не використовувався
+    static Entry* findVictim() {
+        Entry* victim = &entries[0];
+        for (int i = 0; i < Profiles::CACHE_SIZE; i++) {
+            if (entries[i].lastUsed == 0) return &entries[i];
+            if (entries[i].lastUsed < victim->lastUsed) victim = &entries[i];
+        }
+        evictions++;
+        return victim;
+    }
+    
+public:
+    static const ScanResult* find(int userId) {
+        Entry* entry = findEntry(userId);
+        if (entry == nullptr) {
+            misses++;
+            return nullptr;
+        }
+        
+        hits++;
+        entry->lastUsed = ++useCounter;
+        return &entry->profile;
+    }
+    
+    // Без оновлення LRU та лічильників
+    static const ScanResult* peek(int userId) {
+        Entry* entry = findEntry(userId);
+        return entry != nullptr ? &entry->profile : nullptr;
+    }
+    
+    static void store(const ScanResult& profile) {
+        if (!profile.success || profile.userId <= 0) return;
+        
+        Entry* entry = findEntry(profile.userId);
+        if (entry == nullptr) {
+            entry = findVictim();
+        }
+        
+        entry->profile = profile;
+        entry->lastUsed = ++useCounter;
+    }
+    
+    // Профілі іншого бекенду показувати не можна
+    static void clear() {
+        for (int i = 0; i < Profiles::CACHE_SIZE; i++) {
+            entries[i].lastUsed = 0;
+        }
+    }
+    
+    static void recordFirstPixel(bool cached, unsigned long elapsedMicros) {
+        if (cached) {
+            cachedFirstPixelMicros += elapsedMicros;
+            cachedSamples++;
+        } else {
+            uncachedFirstPixelMicros += elapsedMicros;
+            uncachedSamples++;
+        }
+    }
+    
+    static unsigned long getHits() { return hits; }
+    static unsigned long getMisses() { return misses; }
+    static unsigned long getEvictions() { return evictions; }
+    static unsigned long getHitRatioPercent() {
+        unsigned long lookups = hits + misses;
+        return lookups > 0 ? hits * 100 / lookups : 0;
+    }
+    static unsigned long getCachedFirstPixelMicros() {
+        return cachedSamples > 0 ? (unsigned long)(cachedFirstPixelMicros / cachedSamples) : 0;
+    }
+    static unsigned long getUncachedFirstPixelMicros() {
+        return uncachedSamples > 0 ? (unsigned long)(uncachedFirstPixelMicros / uncachedSamples) : 0;
+    }
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#ifdef ELEVATE_RENDER_BENCHMARK
+
+#ifdef ELEVATE_CANVAS_RENDER
+#error "render benchmark compares GFX text with the glyph atlas; build it without ELEVATE_CANVAS_RENDER"
+#endif
+
+#include <Arduino.h>
+#include "types.h"
+#include "modules/retained_screen.h"
+#include "modules/led_display.h"
+#include "modules/glyph_atlas.h"
+
+// ============================================================================
+// RenderBenchmark - Текст через GFX проти атласу гліфів на реальних екранах
+// ============================================================================
+// Збирається лише в env esp32doit-devkit-v1-renderbench. Один раз під час
+// старту малює кожен екран повністю (full) і з одним зміненим рядком
+// (update) обома способами й друкує середній час кадру та ціну атласу:
+//   [renderbench] screen=profile mode=atlas full_us=... update_us=... speedup=...
+//   [renderbench] atlas.ram=...B line.ram=...B atlas.flash=0B atlas.build_us=...
+class RenderBenchmark {
+private:
+    static const int ITERATIONS = 20;
+    
+    enum Screen { PROFILE_CASE, LEADERBOARD_CASE, ERROR_CASE, WAITING_CASE, STATUS_CASE, CASE_COUNT };
+    
+    static void fillProfile(ScanResult& result, int points) {
+        result.success = true;
+        result.userId = 42;
+        result.fullName = "Olena Kovalenko";
+        result.teamPoints = points;
+        result.teamLevelName = "Gold";
+        result.recentBadges[0] = "Early Bird";
+        result.badgeCount = 1;
+    }
+    
+    static void fillLeaderboard(LeaderboardEntry* entries, int firstPoints) {
+        for (int i = 0; i < Display::MAX_LEADERBOARD_ENTRIES; i++) {
+            entries[i].userId = 100 + i;
+            entries[i].rank = i + 1;
+            entries[i].fullName = "Participant";
+            entries[i].teamPoints = firstPoints - i * 137;
+            entries[i].teamLevel = "Silver";
+        }
+    }
+    
+    // variant змінює один рядок екрана між кадрами
+    static void draw(Screen screen, int variant) {
+        if (screen == PROFILE_CASE) {
+            ScanResult result;
+            fillProfile(result, 12840 + variant);
+            LedDisplay::showUserProfile(result);
+        } else if (screen == LEADERBOARD_CASE) {
+            LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+            fillLeaderboard(entries, 20000 + variant);
+            LedDisplay::showLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES);
+        } else if (screen == ERROR_CASE) {
+            LedDisplay::showError(variant % 2 == 0 ? "User ID 42: Unknown user" : "User ID 43: Unknown user");
+        } else if (screen == WAITING_CASE) {
+            LedDisplay::showWaitingMessage();
+        } else {
+            LedDisplay::showSystemStatus();
+        }
+    }
+    
+    static unsigned long measure(Screen screen, bool full) {
+        draw(screen, 0);
+        
+        unsigned long start = micros();
+        for (int i = 1; i <= ITERATIONS; i++) {
+            if (full) RetainedScreen::invalidate();
+            draw(screen, i);
+        }
+        return (micros() - start) / ITERATIONS;
+    }
+    
+    static const char* getName(Screen screen) {
+        static const char* names[] = { "profile", "leaderboard", "error", "waiting", "status" };
+        return names[screen];
+    }
+
+public:
+    static void run() {
+        for (int screen = 0; screen < CASE_COUNT; screen++) {
+            unsigned long baseline = 0;
+            for (int atlas = 0; atlas <= 1; atlas++) {
+                RetainedScreen::setGlyphAtlas(atlas == 1);
+                unsigned long fullMicros = measure((Screen)screen, true);
+                unsigned long updateMicros = measure((Screen)screen, false);
+                if (atlas == 0) baseline = fullMicros;
+                
+                unsigned long speedup = fullMicros > 0 ? baseline * 100 / fullMicros : 0;
+                Serial.printf("[renderbench] screen=%s mode=%s full_us=%lu update_us=%lu speedup=%lu.%02lux\n",
+                              getName((Screen)screen), RetainedScreen::getRenderMode(),
+                              fullMicros, updateMicros, speedup / 100, speedup % 100);
+            }
+        }
+        
+        // Атлас будується з шрифту під час старту, тож у флеші даних не додає
+        Serial.printf("[renderbench] atlas.ram=%uB line.ram=%uB atlas.flash=0B atlas.build_us=%lu\n",
+                      (unsigned)GlyphAtlas::getBytes(),
+                      (unsigned)RetainedScreen::getLineBufferBytes(),
+                      GlyphAtlas::getBuildMicros());
+        RetainedScreen::invalidate();
+    }
+};
+
+#endif
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "constants.h"
+#include "display.h"
+#include "fixed_string.h"
+#include "modules/latency_stats.h"
+#include "modules/glyph_atlas.h"
+
+// ============================================================================
+// RetainedScreen - Перемальовування лише змінених ділянок екрана
+// ============================================================================
+// Кожен рядок екрана - це слот, який пам'ятає свій останній текст.
+// Повністю екран очищується тільки при зміні самого екрана, а в межах
+// одного екрана перемальовуються лише слоти з новим вмістом
+class RetainedScreen {
+public:
+    enum Screen : uint8_t {
+        NO_SCREEN,
+        LOADING_SCREEN,
+        PROFILE_SCREEN,
+        ERROR_SCREEN,
+        LEADERBOARD_SCREEN,
+        WAITING_SCREEN,
+        SCANNING_SCREEN,
+        OFFLINE_SCREEN,
+        STATUS_SCREEN,
+        DIAGNOSTICS_SCREEN,
+        SCREEN_COUNT
+    };
+    
+private:
+    struct Slot {
+        bool valid;
+        int16_t x;
+        int16_t y;
+        uint8_t size;
+        uint16_t color;
+        uint16_t width;
+        FixedString<Display::MAX_LINE_LENGTH> text;
+    };
+    
+    static const uint16_t BACKGROUND = ILI9341_BLACK;
+    static const int CHAR_WIDTH = 6;
+    static const int CHAR_HEIGHT = 8;
+    
+    static Slot slots[Display::MAX_TEXT_SLOTS];
+    static Screen currentScreen;
+    static unsigned long framePixels;
+    static unsigned long lastFramePixels;
+    static unsigned long totalPixels;
+    static unsigned long frameCount;
+    static unsigned long frameStartMicros;
+    static uint32_t frameStartCycles;
+    static uint32_t flushCycles;
+    static unsigned long lastFrameMicros[SCREEN_COUNT];
+    static unsigned long maxFrameMicros[SCREEN_COUNT];
+    
+#ifdef ELEVATE_CANVAS_RENDER
+    static GFXcanvas16 strip;
+    
+    // Слот спершу складається у смузі в RAM, а потім іде на дисплей одним
+    // вікном; старий хвіст стирається в тій самій передачі
+    static void renderText(const Slot& slot, uint16_t drawWidth) {
+        int16_t height = CHAR_HEIGHT * slot.size;
+        drawWidth = min((int)drawWidth, (int)strip.width());
+        if (drawWidth == 0) return;
+        
+        strip.fillRect(0, 0, drawWidth, height, BACKGROUND);
+        strip.setTextSize(slot.size);
+        strip.setTextColor(slot.color);
+        strip.setCursor(0, 0);
+        strip.print(slot.text.c_str());
+        
+        int16_t visibleWidth = min((int)drawWidth, display.width() - slot.x);
+        if (visibleWidth <= 0) return;
+        
+        const uint16_t* buffer = strip.getBuffer();
+        uint32_t start = LatencyStats::now();
+        display.startWrite();
+        display.setAddrWindow(slot.x, slot.y, visibleWidth, height);
+        for (int16_t row = 0; row < height; row++) {
+            display.writePixels(const_cast<uint16_t*>(buffer) + row * strip.width(), visibleWidth);
+        }
+        display.endWrite();
+        flushCycles += LatencyStats::now() - start;
+        framePixels += (unsigned long)visibleWidth * height;
+    }
+#else
+    static bool glyphAtlas;
+    static uint16_t lineBuffer[Display::LINE_BUFFER_WIDTH];
+    
+    // Рядок пікселів збирається з атласу й повторюється size разів, тож
+    // увесь слот разом зі стертим хвостом іде на дисплей одним вікном
+    static void renderAtlasText(const Slot& slot, uint16_t drawWidth) {
+        int16_t height = CHAR_HEIGHT * slot.size;
+        int16_t visibleWidth = min((int)drawWidth, min((int)Display::LINE_BUFFER_WIDTH, display.width() - slot.x));
+        if (visibleWidth <= 0) return;
+        
+        const char* text = slot.text.c_str();
+        int length = slot.text.length();
+        uint32_t start = LatencyStats::now();
+        display.startWrite();
+        display.setAddrWindow(slot.x, slot.y, visibleWidth, height);
+        for (int y = 0; y < CHAR_HEIGHT; y++) {
+            int16_t x = 0;
+            for (int i = 0; i < length && x < visibleWidth; i++) {
+                uint8_t bits = GlyphAtlas::getRow(text[i], y);
+                for (int bit = CHAR_WIDTH - 1; bit >= 0 && x < visibleWidth; bit--) {
+                    uint16_t color = (bits >> bit) & 1 ? slot.color : BACKGROUND;
+                    for (int repeat = 0; repeat < slot.size && x < visibleWidth; repeat++) {
+                        lineBuffer[x++] = color;
+                    }
+                }
+            }
+            while (x < visibleWidth) lineBuffer[x++] = BACKGROUND;
+            
+            for (int repeat = 0; repeat < slot.size; repeat++) {
+                display.writePixels(lineBuffer, visibleWidth);
+            }
+        }
+        display.endWrite();
+        flushCycles += LatencyStats::now() - start;
+        framePixels += (unsigned long)visibleWidth * height;
+    }
+    
+    // Фон символів перекриває старий текст, тож окремо очищується
+    // лише хвіст, якщо новий рядок коротший
+    static void renderText(const Slot& slot, uint16_t drawWidth) {
+        if (glyphAtlas) {
+            renderAtlasText(slot, drawWidth);
+            return;
+        }
+        
+        int16_t height = CHAR_HEIGHT * slot.size;
+        uint16_t width = slot.text.length() * CHAR_WIDTH * slot.size;
+        
+        if (width > 0) {
+            uint32_t start = LatencyStats::now();
+            display.setTextSize(slot.size);
+            display.setTextColor(slot.color, BACKGROUND);
+            display.setCursor(slot.x, slot.y);
+            display.print(slot.text.c_str());
+            flushCycles += LatencyStats::now() - start;
+            framePixels += (unsigned long)width * height;
+        }
+        
+        clearArea(slot.x + width, slot.y, drawWidth - width, height);
+    }
+#endif
+    
+    static void clearArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+        fillRect(x, y, w, h, BACKGROUND);
+    }
+    
+public:
+    // Повертає true, якщо екран змінився і був очищений повністю
+    static bool beginFrame(Screen screen) {
+        frameStartMicros = micros();
+        frameStartCycles = LatencyStats::now();
+        flushCycles = 0;
+        framePixels = 0;
+        if (screen == currentScreen) return false;
+        
+        uint32_t start = LatencyStats::now();
+        display.fillScreen(BACKGROUND);
+        flushCycles += LatencyStats::now() - start;
+        framePixels += (unsigned long)display.width() * display.height();
+        
+        for (int i = 0; i < Display::MAX_TEXT_SLOTS; i++) {
+            slots[i].valid = false;
+            slots[i].width = 0;
+        }
+        currentScreen = screen;
+        return true;
+    }
+    
+    static void endFrame() {
+        unsigned long elapsed = micros() - frameStartMicros;
+        lastFrameMicros[currentScreen] = elapsed;
+        if (elapsed > maxFrameMicros[currentScreen]) maxFrameMicros[currentScreen] = elapsed;
+        
+        lastFramePixels = framePixels;
+        totalPixels += framePixels;
+        frameCount++;
+        
+        LatencyStats::record(LatencyStats::RENDER_STAGE, frameStartCycles);
+        LatencyStats::recordCycles(LatencyStats::FLUSH_STAGE, flushCycles);
+    }
+    
+    // Малює текст у слот, якщо його вміст змінився з минулого кадру
+    static void drawText(int index, int16_t x, int16_t y, uint8_t size, uint16_t color, const char* text) {
+        Slot& slot = slots[index];
+        
+        if (slot.valid && slot.x == x && slot.y == y && slot.size == size &&
+            slot.color == color && slot.text == text) {
+            return;
+        }
+        
+        if (slot.valid && (slot.x != x || slot.y != y || slot.size != size)) {
+            clearArea(slot.x, slot.y, slot.width, CHAR_HEIGHT * slot.size);
+            slot.width = 0;
+        }
+        
+        uint16_t previousWidth = slot.valid ? slot.width : 0;
+        slot.text = text;
+        slot.x = x;
+        slot.y = y;
+        slot.size = size;
+        slot.color = color;
+        slot.width = slot.text.length() * CHAR_WIDTH * size;
+        slot.valid = true;
+        
+        renderText(slot, max(slot.width, previousWidth));
+    }
+    
+    static void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (w <= 0 || h <= 0) return;
+        uint32_t start = LatencyStats::now();
+        display.fillRect(x, y, w, h, color);
+        flushCycles += LatencyStats::now() - start;
+        framePixels += (unsigned long)w * h;
+    }
+    
+    static void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        uint32_t start = LatencyStats::now();
+        display.drawRect(x, y, w, h, color);
+        flushCycles += LatencyStats::now() - start;
+        framePixels += 2UL * (w + h);
+    }
+    
+    static int textWidth(const char* text, uint8_t size) {
+        return strlen(text) * CHAR_WIDTH * size;
+    }
+    
+    static void invalidate() {
+        currentScreen = NO_SCREEN;
+    }
+    
+#ifndef ELEVATE_CANVAS_RENDER
+    // Атлас будується при першому ввімкненні; без нього текст іде
+    // через drawChar() бібліотеки GFX
+    static void setGlyphAtlas(bool enabled) {
+        if (enabled) GlyphAtlas::build();
+        glyphAtlas = enabled;
+        invalidate();
+    }
+    
+    static size_t getLineBufferBytes() { return sizeof(lineBuffer); }
+#endif
+    
+    static Screen getCurrentScreen() { return currentScreen; }
+    static unsigned long getLastFramePixels() { return lastFramePixels; }
+    static unsigned long getFrameCount() { return frameCount; }
+    static unsigned long getLastFrameMicros(Screen screen) { return lastFrameMicros[screen]; }
+    static unsigned long getMaxFrameMicros(Screen screen) { return maxFrameMicros[screen]; }
+    
+    static const char* getRenderMode() {
+#ifdef ELEVATE_CANVAS_RENDER
+        return "canvas";
+#else
+        return glyphAtlas ? "atlas" : "direct";
+#endif
+    }
+    
+    static unsigned long getAverageFramePixels() {
+        return frameCount > 0 ? totalPixels / frameCount : 0;
+    }
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MFRC522.h>
+#include "constants.h"
+#include "modules/input_events.h"
+#include "modules/badge_directory.h"
+
+// ============================================================================
+// RfidReader - Зчитувач MFRC522 з перериванням на лінії IRQ
+// ============================================================================
+class RfidReader {
+private:
+    static MFRC522 reader;
+    static bool present;
+    static uint64_t lastCardKey;
+    static unsigned long lastCardTime;
+    static unsigned long cardsRead;
+    static unsigned long repeatedCards;
+    static unsigned long readErrors;
+    
+    static void clearInterrupts() {
+        reader.PCD_WriteRegister(MFRC522::ComIrqReg, 0x7F);
+    }
+    
+    // Зчитувач сам не шукає картки: раз на інтервал надсилаємо REQA
+    // і чекаємо на IRQ замість повного опитування через SPI
+    static void activateReception() {
+        reader.PCD_WriteRegister(MFRC522::FIFODataReg, MFRC522::PICC_CMD_REQA);
+        reader.PCD_WriteRegister(MFRC522::CommandReg, MFRC522::PCD_Transceive);
+        reader.PCD_WriteRegister(MFRC522::BitFramingReg, 0x87);
+    }
+    
+public:
+    static void initialize() {
+        reader.PCD_Init();
+        
+        // Без модуля SPI повертає 0x00 або 0xFF — лишаються тільки кнопки
+        byte version = reader.PCD_ReadRegister(MFRC522::VersionReg);
+        present = version != 0x00 && version != 0xFF;
+        if (!present) return;
+        
+        // Переривання лише на прийом відповіді картки (RxIEn, IRQ інвертований).
+        // Типово вихід IRQ з відкритим стоком, а на GPIO34–39 немає
+        // внутрішньої підтяжки — тож лінія push-pull (IRQPushPull)
+        reader.PCD_WriteRegister(MFRC522::ComIEnReg, 0xA0);
+        reader.PCD_WriteRegister(MFRC522::DivIEnReg, 0x80);
+        
+        // Переривання за рівнем: застарілий IRQ дав би хибну картку
+        clearInterrupts();
+        InputEvents::attachIrq(Hardware::RFID_IRQ, InputEvents::RFID_CARD);
+        activateReception();
+    }
+    
+    // Викликається таймером раз на RFID_ACTIVATE_INTERVAL_MS
+    static void service() {
+        if (!present) return;
+        
+        clearInterrupts();
+        activateReception();
+    }
+    
+    // Повертає ключ картки для BadgeDirectory або 0, якщо картку
+    // не вдалося прочитати чи її щойно вже прочитали
+    static uint64_t readCard() {
+        if (!present) return 0;
+        
+        uint64_t key = 0;
+        if (reader.PICC_ReadCardSerial()) {
+            key = BadgeDirectory::makeKey(reader.uid.uidByte, reader.uid.size);
+        }
+        
+        clearInterrupts();
+        reader.PICC_HaltA();
+        
+        if (key == 0) {
+            readErrors++;
+            return 0;
+        }
+        
+        unsigned long now = millis();
+        if (key == lastCardKey && now - lastCardTime < Timing::RFID_REPEAT_MS) {
+            lastCardTime = now;
+            repeatedCards++;
+            return 0;
+        }
+        
+        lastCardKey = key;
+        lastCardTime = now;
+        cardsRead++;
+        return key;
+    }
+    
+    static bool isPresent() { return present; }
+    static unsigned long getCardsRead() { return cardsRead; }
+    static unsigned long getRepeatedCards() { return repeatedCards; }
+    static unsigned long getReadErrors() { return readErrors; }
+};
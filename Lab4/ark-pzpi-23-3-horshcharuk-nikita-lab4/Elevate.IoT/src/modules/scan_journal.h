@@ -0,0 +1,219 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <Preferences.h>
+#include "constants.h"
+
+// ============================================================================
+// ScanJournal - Журнал сканувань, не відправлених через мережу
+// ============================================================================
+// Час сканування не зберігається: годинника реального часу немає, а
+// millis() після перезапуску нічого не означає
+struct JournalRecord {
+    uint32_t userId;
+    uint32_t crc;
+};
+
+// Файлом володіє лише мережева задача; UI читає тільки лічильники
+class ScanJournal {
+private:
+    static const size_t RECORD_SIZE = sizeof(JournalRecord);
+    
+    static bool mounted;
+    static File drainFile;
+    static uint32_t headOffset;
+    static uint32_t committedHead;
+    static uint32_t fileSize;
+    static volatile uint32_t pendingRecords;
+    static unsigned long appendedRecords;
+    static unsigned long sentRecords;
+    static unsigned long droppedRecords;
+    static unsigned long corruptRecords;
+    static unsigned long flashBytesWritten;
+    static unsigned long drainMillis;
+    static unsigned long drainStartedAt;
+    
+    static uint32_t crc32(const uint8_t* data, size_t length) {
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < length; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+    
+    static uint32_t recordCrc(const JournalRecord& record) {
+        return crc32((const uint8_t*)&record, offsetof(JournalRecord, crc));
+    }
+    
+    static void updatePending() {
+        pendingRecords = (fileSize - headOffset) / RECORD_SIZE;
+    }
+    
+    // Позиція читання зберігається в NVS раз на пакет, а не на кожен запис
+    static void commitHead() {
+        if (headOffset == committedHead) return;
+        
+        Preferences prefs;
+        if (prefs.begin("journal", false)) {
+            prefs.putUInt("head", headOffset);
+            prefs.end();
+            flashBytesWritten += sizeof(headOffset);
+        }
+        committedHead = headOffset;
+    }
+    
+    // Переписує невідправлені цілі записи в новий файл: прибирає вже
+    // відправлену частину та обірваний хвіст після втрати живлення
+    static void compact() {
+        File source = LittleFS.open(Journal::FILE_PATH, FILE_READ);
+        File target = LittleFS.open(Journal::TEMP_FILE_PATH, FILE_WRITE);
+        if (!source || !target) return;
+        
+        uint32_t written = 0;
+        JournalRecord record;
+        source.seek(headOffset);
+        while (source.read((uint8_t*)&record, RECORD_SIZE) == RECORD_SIZE) {
+            if (record.crc != recordCrc(record)) {
+                corruptRecords++;
+                continue;
+            }
+            target.write((const uint8_t*)&record, RECORD_SIZE);
+            written += RECORD_SIZE;
+        }
+        source.close();
+        target.close();
+        
+        // Позиція скидається до заміни файлу: після збою запис краще
+        // відправити двічі, ніж загубити
+        headOffset = 0;
+        commitHead();
+        
+        LittleFS.remove(Journal::FILE_PATH);
+        LittleFS.rename(Journal::TEMP_FILE_PATH, Journal::FILE_PATH);
+        flashBytesWritten += written;
+        
+        fileSize = written;
+        updatePending();
+    }
+    
+public:
+    static void initialize() {
+        mounted = LittleFS.begin(true);
+        if (!mounted) return;
+        
+        Preferences prefs;
+        if (prefs.begin("journal", true)) {
+            headOffset = prefs.getUInt("head", 0);
+            prefs.end();
+        }
+        committedHead = headOffset;
+        
+        fileSize = 0;
+        if (LittleFS.exists(Journal::FILE_PATH)) {
+            File file = LittleFS.open(Journal::FILE_PATH, FILE_READ);
+            fileSize = file.size();
+            file.close();
+        }
+        
+        if (headOffset > fileSize || headOffset % RECORD_SIZE != 0) {
+            headOffset = 0;
+        }
+        if (fileSize % RECORD_SIZE != 0) {
+            compact();
+        }
+        updatePending();
+    }
+    
+    static bool append(int userId) {
+        if (!mounted || pendingRecords >= Journal::MAX_RECORDS) {
+            droppedRecords++;
+            return false;
+        }
+        
+        if (fileSize >= Journal::MAX_RECORDS * RECORD_SIZE) {
+            compact();
+        }
+        
+        JournalRecord record;
+        record.userId = userId;
+        record.crc = recordCrc(record);
+        
+        File file = LittleFS.open(Journal::FILE_PATH, FILE_APPEND);
+        if (!file || file.write((const uint8_t*)&record, RECORD_SIZE) != RECORD_SIZE) {
+            droppedRecords++;
+            return false;
+        }
+        file.close();
+        
+        fileSize += RECORD_SIZE;
+        flashBytesWritten += RECORD_SIZE;
+        appendedRecords++;
+        updatePending();
+        return true;
+    }
+    
+    static void beginDrain() {
+        drainStartedAt = millis();
+        if (mounted && pendingRecords > 0) {
+            drainFile = LittleFS.open(Journal::FILE_PATH, FILE_READ);
+        }
+    }
+    
+    // Повертає запис на позиції читання, пропускаючи пошкоджені
+    static bool next(JournalRecord& record) {
+        if (!drainFile) return false;
+        
+        while (headOffset < fileSize) {
+            drainFile.seek(headOffset);
+            if (drainFile.read((uint8_t*)&record, RECORD_SIZE) != RECORD_SIZE) return false;
+            if (record.crc == recordCrc(record)) return true;
+            
+            corruptRecords++;
+            headOffset += RECORD_SIZE;
+            updatePending();
+        }
+        return false;
+    }
+    
+    static void consume() {
+        headOffset += RECORD_SIZE;
+        sentRecords++;
+        updatePending();
+    }
+    
+    static void endDrain() {
+        if (drainFile) drainFile.close();
+        
+        // Повністю відправлений журнал просто видаляється
+        if (mounted && headOffset >= fileSize && fileSize > 0) {
+            LittleFS.remove(Journal::FILE_PATH);
+            fileSize = 0;
+            headOffset = 0;
+            updatePending();
+        }
+        commitHead();
+        drainMillis += millis() - drainStartedAt;
+    }
+    
+    static uint32_t getPendingRecords() { return pendingRecords; }
+    static uint32_t getFileBytes() { return fileSize; }
+    static unsigned long getAppendedRecords() { return appendedRecords; }
+    static unsigned long getSentRecords() { return sentRecords; }
+    static unsigned long getDroppedRecords() { return droppedRecords; }
+    static unsigned long getCorruptRecords() { return corruptRecords; }
+    
+    // Записів за секунду активного вивантаження
+    static unsigned long getDrainRate() {
+        return drainMillis > 0 ? sentRecords * 1000 / drainMillis : 0;
+    }
+    
+    // Байтів записано у флеш на 100 байтів корисних записів
+    static unsigned long getWriteAmplificationPercent() {
+        unsigned long payload = appendedRecords * RECORD_SIZE;
+        return payload > 0 ? flashBytesWritten * 100 / payload : 0;
+    }
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+
+// ============================================================================
+// Scheduler - Таймери з дедлайнами для кооперативного loop()
+// ============================================================================
+// Дедлайни в мікросекундах, тож інтервал таймера - до ~35 хвилин
+class Scheduler {
+public:
+    typedef void (*Callback)();
+    
+    static const unsigned long NO_DEADLINE = ~0UL;
+    
+    enum TimerId : uint8_t {
+        HOLD_TIMER,
+        DASHBOARD_TIMER,
+        JOURNAL_TIMER,
+        RFID_TIMER,
+        WIFI_TIMER,
+        STATUS_TIMER,
+        TIMER_COUNT
+    };
+    
+private:
+    struct Timer {
+        unsigned long deadline;
+        unsigned long period;
+        Callback callback;
+        bool armed;
+    };
+    
+    static Timer timers[TIMER_COUNT];
+    static uint8_t queue[TIMER_COUNT];
+    static int queued;
+    static TaskHandle_t loopTask;
+    static unsigned long firedTimers;
+    static unsigned long missedDeadlines;
+    static unsigned long lastJitterMicros;
+    static unsigned long maxJitterMicros;
+    static uint64_t totalJitterMicros;
+    static unsigned long wakeups;
+    static uint64_t sleptMicros;
+    static unsigned long startedAt;
+    
+    static bool isBefore(unsigned long a, unsigned long b) {
+        return (long)(a - b) < 0;
+    }
+    
+    static void unqueue(TimerId id) {
+        for (int i = 0; i < queued; i++) {
+            if (queue[i] != id) continue;
+            
+            for (int j = i; j < queued - 1; j++) {
+                queue[j] = queue[j + 1];
+            }
+            queued--;
+            return;
+        }
+    }
+    
+    // Черга впорядкована за дедлайном, тож найближчий таймер завжди перший
+    static void enqueue(TimerId id) {
+        int position = queued;
+        while (position > 0 && isBefore(timers[id].deadline, timers[queue[position - 1]].deadline)) {
+            queue[position] = queue[position - 1];
+            position--;
+        }
+        queue[position] = id;
+        queued++;
+    }
+    
+    static void arm(TimerId id, unsigned long deadline, unsigned long period, Callback callback) {
+        if (timers[id].armed) unqueue(id);
+        
+        timers[id].deadline = deadline;
+        timers[id].period = period;
+        timers[id].callback = callback;
+        timers[id].armed = true;
+        enqueue(id);
+    }
+    
+    static void recordLateness(unsigned long lateness) {
+        firedTimers++;
+        lastJitterMicros = lateness;
+        totalJitterMicros += lateness;
+        if (lateness > maxJitterMicros) maxJitterMicros = lateness;
+        if (lateness > Timing::TIMER_MISS_TOLERANCE_MS * 1000UL) missedDeadlines++;
+    }
+    
+public:
+    // Викликається з setup(): loop() виконується в тій самій задачі
+    static void begin() {
+        loopTask = xTaskGetCurrentTaskHandle();
+        startedAt = millis();
+    }
+    
+    // Одноразовий таймер; повторний виклик переносить дедлайн
+    static void after(TimerId id, unsigned long delayMs, Callback callback) {
+        arm(id, micros() + delayMs * 1000UL, 0, callback);
+    }
+    
+    static void every(TimerId id, unsigned long periodMs, Callback callback) {
+        arm(id, micros() + periodMs * 1000UL, periodMs * 1000UL, callback);
+    }
+    
+    static void cancel(TimerId id) {
+        if (!timers[id].armed) return;
+        unqueue(id);
+        timers[id].armed = false;
+    }
+    
+    static bool isArmed(TimerId id) { return timers[id].armed; }
+    
+    // Скільки лишилося до найближчого дедлайну
+    static unsigned long getMicrosUntilDeadline() {
+        if (queued == 0) return NO_DEADLINE;
+        
+        unsigned long now = micros();
+        unsigned long deadline = timers[queue[0]].deadline;
+        return isBefore(now, deadline) ? deadline - now : 0;
+    }
+    
+    // Виконує всі таймери, чий дедлайн настав
+    static void runDue() {
+        while (queued > 0) {
+            TimerId id = (TimerId)queue[0];
+            Timer& timer = timers[id];
+            unsigned long now = micros();
+            if (isBefore(now, timer.deadline)) return;
+            
+            recordLateness(now - timer.deadline);
+            unqueue(id);
+            
+            // Періодичний таймер тримає свою сітку; пропущені періоди
+            // не наздоганяються пачкою
+            if (timer.period > 0) {
+                timer.deadline += timer.period;
+                if (isBefore(timer.deadline, now)) timer.deadline = now + timer.period;
+                enqueue(id);
+            } else {
+                timer.armed = false;
+            }
+            
+            timer.callback();
+        }
+    }
+    
+    // Спить до найближчого дедлайну або до сповіщення
+    static void sleep() {
+        TickType_t ticks = portMAX_DELAY;
+        if (queued > 0) {
+            unsigned long now = micros();
+            unsigned long deadline = timers[queue[0]].deadline;
+            if (!isBefore(now, deadline)) return;
+            
+            // Округлення вгору, щоб не прокинутися раніше дедлайну
+            unsigned long waitMs = (deadline - now + 999) / 1000;
+            ticks = pdMS_TO_TICKS(waitMs);
+            if (ticks == 0) ticks = 1;
+        }
+        
+        unsigned long start = micros();
+        ulTaskNotifyTake(pdTRUE, ticks);
+        sleptMicros += micros() - start;
+        wakeups++;
+    }
+    
+    static void notify() {
+        if (loopTask != nullptr) xTaskNotifyGive(loopTask);
+    }
+    
+    static void IRAM_ATTR notifyFromIsr() {
+        if (loopTask == nullptr) return;
+        
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(loopTask, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    
+    static unsigned long getFiredTimers() { return firedTimers; }
+    static unsigned long getMissedDeadlines() { return missedDeadlines; }
+    static unsigned long getLastJitterMicros() { return lastJitterMicros; }
+    static unsigned long getMaxJitterMicros() { return maxJitterMicros; }
+    static unsigned long getAverageJitterMicros() {
+        return firedTimers > 0 ? (unsigned long)(totalJitterMicros / firedTimers) : 0;
+    }
+    static unsigned long getWakeups() { return wakeups; }
+    static uint64_t getSleptMicros() { return sleptMicros; }
+    
+    // Частка часу з моменту старту, яку loop() проспав
+    static unsigned long getIdlePercent() {
+        uint64_t uptime = (uint64_t)(millis() - startedAt) * 1000ULL;
+        return uptime > 0 ? (unsigned long)(sleptMicros * 100 / uptime) : 0;
+    }
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "modules/wifi_manager.h"
+#include "modules/api_client.h"
+#include "modules/network_worker.h"
+#include "modules/retained_screen.h"
+#include "modules/input_events.h"
+#include "modules/badge_directory.h"
+#include "modules/rfid_reader.h"
+#include "modules/scan_journal.h"
+#include "modules/profile_cache.h"
+#include "modules/core_logic.h"
+#include "modules/leaderboard_stream.h"
+#include "modules/dashboard_poller.h"
+#include "modules/scheduler.h"
+#include "modules/boot_trace.h"
+#include "modules/latency_stats.h"
+#include "modules/core_load.h"
+#include "modules/power_manager.h"
+#include "modules/config_manager.h"
+#include "modules/config_console.h"
+
+// ============================================================================
+// StatusReport - Періодичний звіт лічильників у Serial
+// ============================================================================
+class StatusReport {
+public:
+    static void print() {
+        Serial.printf("[status] http.reused=%lu http.new=%lu http.stale=%lu\n",
+                      ApiClient::getReusedConnections(),
+                      ApiClient::getNewConnections(),
+                      ApiClient::getStaleReconnects());
+        Serial.printf("[status] net.queue=%d net.queue.peak=%d net.done=%lu net.dropped=%lu "
+                      "net.stalls=%lu net.lat.last=%lu net.lat.avg=%lu net.lat.max=%lu\n",
+                      NetworkWorker::getQueueDepth(),
+                      NetworkWorker::getPeakQueueDepth(),
+                      NetworkWorker::getCompletedJobs(),
+                      NetworkWorker::getDroppedJobs(),
+                      NetworkWorker::getHandoffStalls(),
+                      NetworkWorker::getLastLatencyMs(),
+                      NetworkWorker::getAverageLatencyMs(),
+                      NetworkWorker::getMaxLatencyMs());
+        Serial.print("[status] cores");
+        for (int core = 0; core < CoreLoad::CORE_COUNT; core++) {
+            Serial.printf(" core%d.busy=%lu%% core%d.%s=%lu%%",
+                          core, CoreLoad::getBusyPercent(core),
+                          core, CoreLoad::getPipelineName(core), CoreLoad::getPipelinePercent(core));
+        }
+        Serial.println();
+        Serial.print("[status] api.errors");
+        for (int i = API_OK + 1; i < API_ERROR_COUNT; i++) {
+            Serial.printf(" %s=%lu", ApiClient::getErrorName((ApiError)i),
+                          ApiClient::getErrorCount((ApiError)i));
+        }
+        Serial.println();
+        Serial.printf("[status] json.parse.last=%luus json.parse.max=%luus json.body=%lu "
+                      "json.pool.peak=%u/%u\n",
+                      ApiClient::getLastParseMicros(),
+                      ApiClient::getMaxParseMicros(),
+                      ApiClient::getLastBodyBytes(),
+                      (unsigned)ApiClient::getParsePoolPeak(),
+                      (unsigned)ApiClient::getParsePoolCapacity());
+        Serial.printf("[status] display.frames=%lu display.px.last=%lu display.px.avg=%lu\n",
+                      RetainedScreen::getFrameCount(),
+                      RetainedScreen::getLastFramePixels(),
+                      RetainedScreen::getAverageFramePixels());
+        Serial.printf("[status] render.mode=%s frame.us.profile=%lu/%lu "
+                      "frame.us.leaderboard=%lu/%lu frame.us.status=%lu/%lu\n",
+                      RetainedScreen::getRenderMode(),
+                      RetainedScreen::getLastFrameMicros(RetainedScreen::PROFILE_SCREEN),
+                      RetainedScreen::getMaxFrameMicros(RetainedScreen::PROFILE_SCREEN),
+                      RetainedScreen::getLastFrameMicros(RetainedScreen::LEADERBOARD_SCREEN),
+                      RetainedScreen::getMaxFrameMicros(RetainedScreen::LEADERBOARD_SCREEN),
+                      RetainedScreen::getLastFrameMicros(RetainedScreen::STATUS_SCREEN),
+                      RetainedScreen::getMaxFrameMicros(RetainedScreen::STATUS_SCREEN));
+        Serial.printf("[status] sched.fired=%lu sched.missed=%lu sched.jitter.last=%luus "
+                      "sched.jitter.avg=%luus sched.jitter.max=%luus sched.wakeups=%lu sched.idle=%lu%%\n",
+                      Scheduler::getFiredTimers(),
+                      Scheduler::getMissedDeadlines(),
+                      Scheduler::getLastJitterMicros(),
+                      Scheduler::getAverageJitterMicros(),
+                      Scheduler::getMaxJitterMicros(),
+                      Scheduler::getWakeups(),
+                      Scheduler::getIdlePercent());
+        Serial.printf("[status] power.mode=%s power.sleeps=%lu power.wake.gpio=%lu power.wake.timer=%lu "
+                      "power.wake.uart=%lu power.sleep=%lu%% power.idle.est=%luuA power.avg.est=%luuA\n",
+                      PowerManager::getMode(),
+                      PowerManager::getSleeps(),
+                      PowerManager::getGpioWakeups(),
+                      PowerManager::getTimerWakeups(),
+                      PowerManager::getUartWakeups(),
+                      PowerManager::getSleepPercent(),
+                      PowerManager::getIdleMicroamps(),
+                      PowerManager::getAverageMicroamps());
+        Serial.printf("[status] scan.ok=%d scan.failed=%d scan.last=%lums\n",
+                      LedDisplay::getSuccessfulScans(),
+                      LedDisplay::getFailedScans(),
+                      CoreLogic::getLastScanResultAt());
+        Serial.printf("[status] input.pending=%u input.peak=%u input.dropped=%lu input.coalesced=%lu\n",
+                      (unsigned)InputEvents::getPendingEvents(),
+                      (unsigned)InputEvents::getPeakPendingEvents(),
+                      InputEvents::getDroppedEvents(),
+                      InputEvents::getCoalescedEvents());
+        Serial.printf("[status] rfid=%s rfid.cards=%lu rfid.repeat=%lu rfid.errors=%lu "
+                      "badge.table=%u/%u badge.flash=%uB badge.ram=%uB\n",
+                      RfidReader::isPresent() ? "on" : "off",
+                      RfidReader::getCardsRead(),
+                      RfidReader::getRepeatedCards(),
+                      RfidReader::getReadErrors(),
+                      BadgeDirectory::getTableCards(),
+                      BadgeDirectory::getTableSlots(),
+                      BadgeDirectory::getTableBytes(),
+                      BadgeDirectory::getCacheBytes());
+        Serial.printf("[status] badge.lookups=%lu badge.hit.flash=%lu badge.hit.cache=%lu "
+                      "badge.miss=%lu badge.lookup.last=%luus badge.lookup.max=%luus\n",
+                      BadgeDirectory::getLookups(),
+                      BadgeDirectory::getTableHits(),
+                      BadgeDirectory::getCacheHits(),
+                      BadgeDirectory::getMisses(),
+                      BadgeDirectory::getLastLookupMicros(),
+                      BadgeDirectory::getMaxLookupMicros());
+        Serial.printf("[status] wire.accept=%s wire.send=%s wire.json=%lu/%luB "
+                      "wire.msgpack=%lu/%luB wire.fallbacks=%lu\n",
+                      ApiClient::getAcceptFormat(),
+                      ApiClient::getSendFormat(),
+                      ApiClient::getJsonResponses(),
+                      ApiClient::getJsonBytes(),
+                      ApiClient::getMsgPackResponses(),
+                      ApiClient::getMsgPackBytes(),
+                      ApiClient::getFormatFallbacks());
+        Serial.printf("[status] leaderboard.304=%lu/%luB leaderboard.same=%lu/%luB leaderboard.same.unparsed=%lu "
+                      "leaderboard.changed=%luB leaderboard.redraws.skipped=%lu\n",
+                      ApiClient::getNotModifiedResponses(),
+                      ApiClient::getNotModifiedBytes(),
+                      ApiClient::getIdenticalResponses(),
+                      ApiClient::getIdenticalBytes(),
+                      ApiClient::getUnparsedResponses(),
+                      ApiClient::getUpdatedBytes(),
+                      CoreLogic::getSkippedRedraws());
+        unsigned long pollRate = DashboardPoller::getRequestRateTenths();
+        Serial.printf("[status] dashboard.interval=%lums dashboard.rate=%lu.%lu/min dashboard.stale=%ldms "
+                      "dashboard.polls=%lu dashboard.changed=%lu dashboard.failed=%lu\n",
+                      DashboardPoller::getIntervalMs(),
+                      pollRate / 10, pollRate % 10,
+                      DashboardPoller::hasFreshData() ? (long)DashboardPoller::getStalenessMs() : -1L,
+                      DashboardPoller::getPolls(),
+                      DashboardPoller::getChangedResults(),
+                      DashboardPoller::getFailedResults());
+        Serial.printf("[status] stream.mode=%s stream.connected=%d stream.unsupported=%d "
+                      "stream.retry=%lums stream.connects=%lu stream.drops=%lu stream.events=%lu stream.rows=%lu\n",
+                      ConfigManager::updateMode == ConfigManager::STREAM_UPDATES ? "sse" : "poll",
+                      LeaderboardStream::isConnected() ? 1 : 0,
+                      LeaderboardStream::isUnsupported() ? 1 : 0,
+                      LeaderboardStream::getRetryMs(),
+                      LeaderboardStream::getConnects(),
+                      LeaderboardStream::getDrops(),
+                      LeaderboardStream::getEvents(),
+                      LeaderboardStream::getChangedRows());
+        Serial.printf("[status] profile.hits=%lu profile.misses=%lu profile.ratio=%lu%% "
+                      "profile.evictions=%lu ttfp.cached=%luus ttfp.uncached=%luus\n",
+                      ProfileCache::getHits(),
+                      ProfileCache::getMisses(),
+                      ProfileCache::getHitRatioPercent(),
+                      ProfileCache::getEvictions(),
+                      ProfileCache::getCachedFirstPixelMicros(),
+                      ProfileCache::getUncachedFirstPixelMicros());
+        unsigned long amplification = ScanJournal::getWriteAmplificationPercent();
+        Serial.printf("[status] journal.pending=%u journal.bytes=%u journal.appended=%lu "
+                      "journal.sent=%lu journal.dropped=%lu journal.corrupt=%lu "
+                      "journal.drain.rps=%lu journal.wa=%lu.%02lu\n",
+                      (unsigned)ScanJournal::getPendingRecords(),
+                      (unsigned)ScanJournal::getFileBytes(),
+                      ScanJournal::getAppendedRecords(),
+                      ScanJournal::getSentRecords(),
+                      ScanJournal::getDroppedRecords(),
+                      ScanJournal::getCorruptRecords(),
+                      ScanJournal::getDrainRate(),
+                      amplification / 100, amplification % 100);
+        Serial.printf("[status] wifi.joins=%lu wifi.fast=%lu wifi.join.last=%lums wifi.losses=%lu "
+                      "wifi.reconnect.last=%lums wifi.reconnect.avg=%lums wifi.reason=%u\n",
+                      WiFiManager::getJoins(),
+                      WiFiManager::getFastJoins(),
+                      WiFiManager::getLastJoinMs(),
+                      WiFiManager::getLosses(),
+                      WiFiManager::getLastOutageMs(),
+                      WiFiManager::getAverageOutageMs(),
+                      WiFiManager::getLastReason());
+        Serial.printf("[status] wifi.loss.hist le250=%lu le500=%lu le1000=%lu le2000=%lu le5000=%lu gt5000=%lu\n",
+                      WiFiManager::getLossHistogram(0),
+                      WiFiManager::getLossHistogram(1),
+                      WiFiManager::getLossHistogram(2),
+                      WiFiManager::getLossHistogram(3),
+                      WiFiManager::getLossHistogram(4),
+                      WiFiManager::getLossHistogram(5));
+        Serial.printf("[status] config.source=%s config.load=%luus config.saves=%lu config.commands=%lu\n",
+                      ConfigManager::isLoadedFromNvs() ? "nvs" : "defaults",
+                      ConfigManager::getLoadMicros(),
+                      ConfigManager::getSaves(),
+                      ConfigConsole::getCommands());
+        Serial.printf("[status] boot.ready=%lums boot.wifi=%lums boot.api=%lums\n",
+                      BootTrace::getPhaseMillis(BootTrace::READY_PHASE),
+                      BootTrace::getPhaseMillis(BootTrace::WIFI_PHASE),
+                      BootTrace::getPhaseMillis(BootTrace::API_PHASE));
+        Serial.printf("[status] heap.free=%u heap.min=%u heap.maxblock=%u\n",
+                      ESP.getFreeHeap(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap());
+        LatencyStats::dump();
+    }
+};
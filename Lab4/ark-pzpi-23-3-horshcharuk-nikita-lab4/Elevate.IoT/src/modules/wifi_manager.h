@@ -1,57 +1,259 @@
 #pragma once
 
 #include <WiFi.h>
+#include <esp_wifi.h>
+#include <Preferences.h>
 #include "constants.h"
 #include "modules/config_manager.h"
+#include "modules/scheduler.h"
 
 // ============================================================================
 // WiFiManager - Мережевий модуль
 // ============================================================================
+// BSSID і канал останньої точки лежать у NVS; якщо точка не відповіла,
+// кеш відкидається і наступна спроба сканує ефір
 class WiFiManager {
 private:
+    struct LinkCache {
+        uint8_t bssid[6];
+        uint8_t channel;
+        uint32_t ip;
+        uint32_t gateway;
+        uint32_t subnet;
+        uint32_t dns;
+        bool valid;
+    };
+    
+    static const int LOSS_BUCKETS = 6;
+    
+    static LinkCache cache;
     static unsigned long lastConnectionAttempt;
-    static bool connectionStatus;
+    static volatile bool connected;
+    static volatile bool linkUp;
+    static volatile bool reconnectPending;
+    static volatile bool cacheRejected;
+    static volatile bool fastJoin;
+    static volatile bool outagePending;
+    static volatile unsigned long joinStartedAt;
+    static volatile unsigned long lostAt;
+    static unsigned long joins;
+    static unsigned long fastJoins;
+    static unsigned long lastJoinMs;
+    static unsigned long losses;
+    static unsigned long lastOutageMs;
+    static unsigned long totalOutageMs;
+    static unsigned long outages;
+    static uint8_t lastReason;
+    static unsigned long lossHistogram[LOSS_BUCKETS];
     
-public:
-    static bool connect() {
-        if (WiFi.status() == WL_CONNECTED) {
-            connectionStatus = true;
-            return true;
+    // Межі кошиків гістограми тривалості втрати лінку, мс
+    static int getLossBucket(unsigned long outageMs) {
+        static const unsigned long limits[LOSS_BUCKETS - 1] = { 250, 500, 1000, 2000, 5000 };
+        for (int i = 0; i < LOSS_BUCKETS - 1; i++) {
+            if (outageMs <= limits[i]) return i;
         }
+        return LOSS_BUCKETS - 1;
+    }
+    
+    static void loadCache() {
+        cache.valid = false;
         
-        unsigned long now = millis();
-        if (now - lastConnectionAttempt < Timing::WIFI_RETRY_INTERVAL_MS) {
-            return false;
+        Preferences prefs;
+        if (!prefs.begin("wifi", true)) return;
+        
+        // Кеш належить конкретній мережі
+        char ssid[Provisioning::SSID_LENGTH + 1] = {};
+        prefs.getString("ssid", ssid, sizeof(ssid));
+        if (strcmp(ssid, ConfigManager::WIFI_SSID) == 0 &&
+            prefs.getBytes("bssid", cache.bssid, sizeof(cache.bssid)) == sizeof(cache.bssid)) {
+            cache.channel = prefs.getUChar("channel", 0);
+            cache.ip = prefs.getUInt("ip", 0);
+            cache.gateway = prefs.getUInt("gateway", 0);
+            cache.subnet = prefs.getUInt("subnet", 0);
+            cache.dns = prefs.getUInt("dns", 0);
+            cache.valid = cache.channel != 0;
         }
+        prefs.end();
+    }
+    
+    // Флеш пишеться лише тоді, коли точка доступу чи адреса змінились
+    static void saveCache() {
+        const uint8_t* bssid = WiFi.BSSID();
+        if (bssid == nullptr) return;
         
-        lastConnectionAttempt = now;
-        WiFi.begin(ConfigManager::WIFI_SSID, ConfigManager::WIFI_PASSWORD);
+        LinkCache current;
+        memcpy(current.bssid, bssid, sizeof(current.bssid));
+        current.channel = WiFi.channel();
+        current.ip = WiFi.localIP();
+        current.gateway = WiFi.gatewayIP();
+        current.subnet = WiFi.subnetMask();
+        current.dns = WiFi.dnsIP();
+        current.valid = true;
         
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < Timing::WIFI_MAX_ATTEMPTS) {
-            delay(Timing::WIFI_CONNECT_DELAY_MS);
-            attempts++;
+        if (cache.valid && memcmp(cache.bssid, current.bssid, sizeof(cache.bssid)) == 0 &&
+            cache.channel == current.channel && cache.ip == current.ip &&
+            cache.gateway == current.gateway && cache.subnet == current.subnet &&
+            cache.dns == current.dns) {
+            return;
         }
         
-        connectionStatus = (WiFi.status() == WL_CONNECTED);
-        return connectionStatus;
+        Preferences prefs;
+        if (!prefs.begin("wifi", false)) return;
+        prefs.putString("ssid", ConfigManager::WIFI_SSID);
+        prefs.putBytes("bssid", current.bssid, sizeof(current.bssid));
+        prefs.putUChar("channel", current.channel);
+        prefs.putUInt("ip", current.ip);
+        prefs.putUInt("gateway", current.gateway);
+        prefs.putUInt("subnet", current.subnet);
+        prefs.putUInt("dns", current.dns);
+        prefs.end();
+        cache = current;
     }
     
-    static bool ensureConnection() {
-        if (WiFi.status() == WL_CONNECTED) {
-            connectionStatus = true;
-            return true;
+    // Інтервал прослуховування WiFi.begin() не задає: begin() лише
+    // готує конфігурацію станції, а асоціацію запускаємо вже з ним
+    static void connectStation() {
+        wifi_config_t config;
+        esp_wifi_get_config(WIFI_IF_STA, &config);
+        config.sta.listen_interval = Power::WIFI_LISTEN_INTERVAL;
+        esp_wifi_set_config(WIFI_IF_STA, &config);
+        esp_wifi_connect();
+    }
+    
+    static void startJoin() {
+        lastConnectionAttempt = millis();
+        joinStartedAt = lastConnectionAttempt;
+        joins++;
+        
+        if (!cache.valid) {
+            fastJoin = false;
+            if (Config::WIFI_REUSE_LEASE) {
+                WiFi.config(IPAddress(), IPAddress(), IPAddress()); // назад на DHCP
+            }
+            WiFi.begin(ConfigManager::WIFI_SSID, ConfigManager::WIFI_PASSWORD, 0, nullptr, false);
+            connectStation();
+            return;
+        }
+        
+        // Статична адреса з минулої оренди економить ще й обмін DHCP
+        if (Config::WIFI_REUSE_LEASE && cache.ip != 0) {
+            WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet),
+                        IPAddress(cache.dns));
+        }
+        fastJoin = true;
+        WiFi.begin(ConfigManager::WIFI_SSID, ConfigManager::WIFI_PASSWORD, cache.channel, cache.bssid, false);
+        connectStation();
+    }
+    
+    // Викликається задачею подій Wi-Fi, тож лише оновлює стан і будить loop()
+    static void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
+        unsigned long now = millis();
+        
+        if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+            connected = true;
+            linkUp = true;
+            lastJoinMs = now - joinStartedAt;
+            if (fastJoin) fastJoins++;
+            
+            if (outagePending) {
+                outagePending = false;
+                lastOutageMs = now - lostAt;
+                totalOutageMs += lastOutageMs;
+                outages++;
+                lossHistogram[getLossBucket(lastOutageMs)]++;
+            }
+        } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+            lastReason = info.wifi_sta_disconnected.reason;
+            
+            if (connected) {
+                connected = false;
+                losses++;
+                if (!outagePending) lostAt = now;
+                outagePending = true;
+                reconnectPending = true;
+            } else if (fastJoin) {
+                // Точка з кешу не відповіла — одразу пробуємо зі скануванням
+                fastJoin = false;
+                cacheRejected = true;
+                reconnectPending = true;
+            }
+        } else {
+            return;
+        }
+        Scheduler::notify();
+    }
+    
+public:
+    // Підключення йде у фоні, поки setup() ініціалізує решту
+    static void begin() {
+        loadCache();
+        
+        // Перепідключенням керує service(), а облікові дані зберігає
+        // ConfigManager, тож бібліотеці не треба писати їх у флеш
+        WiFi.persistent(false);
+        WiFi.setAutoReconnect(false);
+        WiFi.onEvent(onWiFiEvent);
+        WiFi.mode(WIFI_STA);
+        // Modem sleep з LISTEN_INTERVAL: радіо прокидається не на кожен
+        // маяк. На час запитів PowerManager тримає радіо без сну
+        WiFi.setSleep(WIFI_PS_MAX_MODEM);
+        startJoin();
+    }
+    
+    // Викликається з loop() після кожного пробудження та таймером:
+    // після втрати лінку перша спроба йде одразу, далі — з інтервалом
+    static void service() {
+        if (cacheRejected) {
+            cacheRejected = false;
+            cache.valid = false;
+        }
+        if (connected) return;
+        
+        if (reconnectPending || millis() - lastConnectionAttempt >= Timing::WIFI_RETRY_INTERVAL_MS) {
+            reconnectPending = false;
+            startJoin();
         }
+    }
+    
+    // Нові облікові дані з консолі: кеш точки належав старим, тож
+    // підключаємось зі скануванням. Розрив тут навмисний і не рахується
+    // як втрата лінку
+    static void rejoin() {
+        connected = false;
+        reconnectPending = false;
+        cacheRejected = false;
+        cache.valid = false;
+        fastJoin = false;
         WiFi.disconnect();
-        delay(100);
-        return connect();
+        startJoin();
+    }
+    
+    // Мережева задача лише перевіряє стан; перепідключенням займається
+    // loop(), тож WiFi.begin() не викликається з двох задач
+    static bool ensureConnection() {
+        return connected;
     }
     
     static bool isConnected() {
-        return WiFi.status() == WL_CONNECTED;
+        return connected;
     }
     
-    static bool getConnectionStatus() { return connectionStatus; }
-    static void setConnectionStatus(bool status) { connectionStatus = status; }
+    // true один раз після кожного отримання IP
+    static bool takeLinkUp() {
+        if (!linkUp) return false;
+        linkUp = false;
+        saveCache();
+        return true;
+    }
+    
+    static unsigned long getJoins() { return joins; }
+    static unsigned long getFastJoins() { return fastJoins; }
+    static unsigned long getLastJoinMs() { return lastJoinMs; }
+    static unsigned long getLosses() { return losses; }
+    static unsigned long getLastOutageMs() { return lastOutageMs; }
+    static unsigned long getAverageOutageMs() {
+        return outages > 0 ? totalOutageMs / outages : 0;
+    }
+    static uint8_t getLastReason() { return lastReason; }
+    static unsigned long getLossHistogram(int bucket) { return lossHistogram[bucket]; }
 };
-
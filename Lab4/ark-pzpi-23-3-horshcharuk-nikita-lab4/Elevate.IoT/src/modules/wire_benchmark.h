@@ -0,0 +1,105 @@
+#pragma once
+
+#ifdef ELEVATE_WIRE_BENCHMARK
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ============================================================================
+// WireBenchmark - Порівняння JSON та MessagePack на типових відповідях
+// ============================================================================
+// Збирається лише в env esp32doit-devkit-v1-wirebench. Один раз під час
+// старту друкує в Serial розмір і середній час кодування/розбору:
+//   [wirebench] case=leaderboard50 format=msgpack bytes=... encode_us=... decode_us=...
+class WireBenchmark {
+private:
+    static const int ITERATIONS = 50;
+    static const size_t BUFFER_SIZE = 8192;
+    
+    enum Format { JSON_FORMAT, MSGPACK_FORMAT };
+    
+    static uint8_t buffer[BUFFER_SIZE];
+    
+    static void fillScanResult(JsonDocument& doc) {
+        doc["userId"] = 42;
+        doc["teamId"] = 7;
+        doc["fullName"] = "Olena Kovalenko";
+        doc["teamPoints"] = 12840;
+        doc["teamLevelName"] = "Gold";
+        JsonArray badges = doc["recentBadges"].to<JsonArray>();
+        badges.add("Early Bird");
+        badges.add("Stair Master");
+        badges.add("Team Player");
+    }
+    
+    static void fillLeaderboard(JsonDocument& doc, int entries) {
+        JsonArray rows = doc.to<JsonArray>();
+        for (int i = 0; i < entries; i++) {
+            JsonObject row = rows.add<JsonObject>();
+            row["rank"] = i + 1;
+            row["userId"] = 100 + i;
+            row["fullName"] = "Participant Name";
+            row["teamPoints"] = 20000 - i * 137;
+            row["teamLevel"] = i < 10 ? "Platinum" : "Silver";
+        }
+    }
+    
+    static size_t encode(JsonDocument& doc, Format format) {
+        return format == MSGPACK_FORMAT ? serializeMsgPack(doc, buffer, BUFFER_SIZE)
+                                        : serializeJson(doc, buffer, BUFFER_SIZE);
+    }
+    
+    static bool decode(JsonDocument& doc, size_t length, Format format) {
+        DeserializationError error = format == MSGPACK_FORMAT
+            ? deserializeMsgPack(doc, buffer, length)
+            : deserializeJson(doc, buffer, length);
+        return error == DeserializationError::Ok;
+    }
+    
+    static void measure(const char* name, JsonDocument& source, Format format) {
+        size_t length = 0;
+        unsigned long start = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            length = encode(source, format);
+        }
+        unsigned long encodeMicros = (micros() - start) / ITERATIONS;
+        
+        bool ok = true;
+        JsonDocument parsed;
+        start = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            ok = decode(parsed, length, format) && ok;
+        }
+        unsigned long decodeMicros = (micros() - start) / ITERATIONS;
+        
+        Serial.printf("[wirebench] case=%s format=%s bytes=%u encode_us=%lu decode_us=%lu%s\n",
+                      name,
+                      format == MSGPACK_FORMAT ? "msgpack" : "json",
+                      (unsigned)length,
+                      encodeMicros,
+                      decodeMicros,
+                      ok ? "" : " error");
+    }
+    
+    static void measureBoth(const char* name, JsonDocument& source) {
+        measure(name, source, JSON_FORMAT);
+        measure(name, source, MSGPACK_FORMAT);
+    }
+    
+public:
+    static void run() {
+        JsonDocument scan;
+        fillScanResult(scan);
+        measureBoth("scan", scan);
+        
+        JsonDocument small;
+        fillLeaderboard(small, 5);
+        measureBoth("leaderboard5", small);
+        
+        JsonDocument large;
+        fillLeaderboard(large, 50);
+        measureBoth("leaderboard50", large);
+    }
+};
+
+#endif
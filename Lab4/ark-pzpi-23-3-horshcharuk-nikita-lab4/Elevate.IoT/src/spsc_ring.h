@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// ============================================================================
+// SpscRing - Кільцевий буфер без блокувань (один виробник, один споживач)
+// ============================================================================
+// Виробник змінює лише head, споживач - лише tail, тому push() можна
+// викликати з переривання, а pop() - з loop() без м'ютексів
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    
+private:
+    static const uint32_t MASK = Capacity - 1;
+    
+    T items[Capacity];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    
+public:
+    SpscRing() : head(0), tail(0) {}
+    
+    bool IRAM_ATTR push(const T& item) {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - tail.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        
+        items[currentHead & MASK] = item;
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+    
+    bool pop(T& item) {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        
+        item = items[currentTail & MASK];
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Як pop(), але елемент лишається в кільці; лише для споживача
+    bool peek(T& item) const {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        
+        item = items[currentTail & MASK];
+        return true;
+    }
+    
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    
+    bool isEmpty() const { return size() == 0; }
+    static size_t capacity() { return Capacity; }
+};
@@ -2,27 +2,53 @@
 
 #include <Arduino.h>
 #include "constants.h"
+#include "fixed_string.h"
 
 // ============================================================================
 // Структури даних
 // ============================================================================
+typedef FixedString<Display::MAX_ERROR_MESSAGE_LENGTH> ErrorText;
+
+// Клас помилки запиту. Текст для екрана будує ApiClient::formatError()
+// лише тоді, коли помилку справді показують
+enum ApiError : uint8_t {
+    API_OK,
+    API_NO_NETWORK,          // Wi-Fi не підключено
+    API_CONNECTION_REFUSED,  // TCP-з'єднання не встановлено
+    API_CONNECTION_LOST,     // сокет закрився посеред запиту
+    API_TIMEOUT,             // відповідь не прийшла вчасно
+    API_TRANSPORT_ERROR,     // інші від'ємні коди HTTPClient
+    API_SERVER_ERROR,        // 5xx
+    API_REJECTED,            // 4xx: сервер відхилив запит
+    API_REDIRECT_FAILED,     // 301/307 без адреси або повторне перенаправлення
+    API_UNEXPECTED_STATUS,   // 1xx/2xx/3xx, крім 200
+    API_BAD_RESPONSE,        // 200, але тіло не розібрано
+    API_ERROR_COUNT
+};
+
+// Сервер недосяжний чи перевантажений: запит варто повторити пізніше
+inline bool isRetryableError(ApiError error) {
+    return error != API_OK && error <= API_SERVER_ERROR;
+}
+
 struct ScanResult {
     int userId = 0;
     int teamId = 0;
-    String fullName;
+    FixedString<Display::MAX_NAME_LENGTH> fullName;
     int teamPoints = 0;
-    String teamLevelName;
-    String recentBadges[Display::MAX_RECENT_BADGES];
+    FixedString<Display::MAX_LEVEL_LENGTH> teamLevelName;
+    FixedString<Display::MAX_BADGE_LENGTH> recentBadges[Display::MAX_RECENT_BADGES];
     int badgeCount = 0;
     bool success = false;
-    String errorMessage;
+    ApiError error = API_OK;
+    int16_t httpCode = 0;       // статус HTTP або від'ємний код HTTPClient
+    ErrorText serverMessage;    // "message" з тіла відповіді 4xx, якщо був
 };
 
 struct LeaderboardEntry {
     int userId = 0;
-    String fullName;
+    FixedString<Display::MAX_LEADERBOARD_NAME_LENGTH> fullName;
     int teamPoints = 0;
-    String teamLevel;
+    FixedString<Display::MAX_LEVEL_LENGTH> teamLevel;
     int rank = 0;
 };
-
@@ -0,0 +1,395 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <unity.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "modules/api_client.h"
+#include "modules/config_manager.h"
+#include "modules/wifi_manager.h"
+#include "modules/latency_stats.h"
+
+// ============================================================================
+// ApiClient проти локального HTTP-сервера
+// ============================================================================
+// Сервер у потоці тесту відповідає на кожен запит заданим текстом і
+// рахує прийняті з'єднання, тож видно, чи ApiClient тримав сокет
+namespace {
+    const unsigned long WIFI_WAIT_MS = 1000;
+    const size_t CHUNK_SIZE = 16;
+    const int STEADY_REQUESTS = 50;
+    const int LONG_LEADERBOARD_ENTRIES = 20;
+    
+    int listenFd = -1;
+    char baseUrl[32];
+    char closedUrl[32];
+    char httpsUrl[32];
+    std::mutex responseMutex;
+    std::string response;
+    bool closeAfterResponse = false;
+    std::atomic<int> accepted(0);
+    std::atomic<int> requests(0);
+    
+    void serve(const std::string& text, bool close) {
+        std::lock_guard<std::mutex> lock(responseMutex);
+        response = text;
+        closeAfterResponse = close;
+    }
+    
+    std::string okResponse(const std::string& body, const char* type = "application/json") {
+        return std::string("HTTP/1.1 200 OK\r\nContent-Type: ") + type + "\r\nContent-Length: " +
+               std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+    
+    // Тіло шматками по CHUNK_SIZE байтів, як його віддає сервер, що не
+    // знає довжини наперед
+    std::string chunkedResponse(const std::string& body) {
+        std::string text = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                           "Transfer-Encoding: chunked\r\n\r\n";
+        for (size_t offset = 0; offset < body.size(); offset += CHUNK_SIZE) {
+            std::string chunk = body.substr(offset, CHUNK_SIZE);
+            char size[8];
+            snprintf(size, sizeof(size), "%x\r\n", (unsigned)chunk.size());
+            text += size + chunk + "\r\n";
+        }
+        return text + "0\r\n\r\n";
+    }
+    
+    // Заголовки до порожнього рядка й тіло за Content-Length
+    bool readRequest(int fd, std::string& pending) {
+        size_t end;
+        while ((end = pending.find("\r\n\r\n")) == std::string::npos) {
+            char buffer[512];
+            ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+            if (length <= 0) return false;
+            pending.append(buffer, length);
+        }
+        
+        size_t bodyLength = 0;
+        size_t header = pending.find("Content-Length: ");
+        if (header != std::string::npos && header < end) bodyLength = atoi(pending.c_str() + header + 16);
+        while (pending.size() < end + 4 + bodyLength) {
+            char buffer[512];
+            ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+            if (length <= 0) return false;
+            pending.append(buffer, length);
+        }
+        pending.erase(0, end + 4 + bodyLength);
+        return true;
+    }
+    
+    void serveConnection(int fd) {
+        std::string pending;
+        while (readRequest(fd, pending)) {
+            requests++;
+            std::string text;
+            bool close;
+            {
+                std::lock_guard<std::mutex> lock(responseMutex);
+                text = response;
+                close = closeAfterResponse;
+            }
+            send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+            if (close) break;
+        }
+        ::close(fd);
+    }
+    
+    void acceptLoop() {
+        for (;;) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;
+            accepted++;
+            std::thread(serveConnection, fd).detach();
+        }
+    }
+    
+    void startServer() {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenFd, (sockaddr*)&address, sizeof(address));
+        listen(listenFd, 8);
+        
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, (sockaddr*)&address, &length);
+        snprintf(baseUrl, sizeof(baseUrl), "http://127.0.0.1:%u", ntohs(address.sin_port));
+        snprintf(httpsUrl, sizeof(httpsUrl), "https://127.0.0.1:%u", ntohs(address.sin_port));
+        std::thread(acceptLoop).detach();
+    }
+    
+    // Порт, який щойно звільнився: з'єднання з ним відхиляється
+    void reserveClosedPort() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd, (sockaddr*)&address, sizeof(address));
+        
+        socklen_t length = sizeof(address);
+        getsockname(fd, (sockaddr*)&address, &length);
+        snprintf(closedUrl, sizeof(closedUrl), "http://127.0.0.1:%u", ntohs(address.sin_port));
+        ::close(fd);
+    }
+}
+
+void setUp() {
+    // Кожен тест починає без відкритого сокета й кешу лідерборду
+    ConfigManager::API_BASE_URL = baseUrl;
+    ApiClient::resetBackend();
+}
+
+void tearDown() {}
+
+// ============================================================================
+// Keep-alive
+// ============================================================================
+void test_requests_share_one_connection() {
+    serve(okResponse("[]"), false);
+    int acceptedBefore = accepted;
+    unsigned long reusedBefore = ApiClient::getReusedConnections();
+    
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    
+    TEST_ASSERT_EQUAL(1, accepted - acceptedBefore);
+    TEST_ASSERT_EQUAL(2, (int)(ApiClient::getReusedConnections() - reusedBefore));
+}
+
+void test_unread_body_does_not_break_next_request() {
+    // probeApi() тіло не розбирає, лише дочитує
+    serve(okResponse("[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\",\"teamPoints\":10}]"), false);
+    int acceptedBefore = accepted;
+    int requestsBefore = requests;
+    
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    
+    TEST_ASSERT_EQUAL(1, accepted - acceptedBefore);
+    TEST_ASSERT_EQUAL(2, requests - requestsBefore);
+}
+
+void test_reconnects_after_server_closes() {
+    // Сокет, закритий сервером, або помічається до запиту, або запит
+    // повторюється на новому з'єднанні — в обох випадках без помилки
+    serve(okResponse("[]"), true);
+    int acceptedBefore = accepted;
+    
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    
+    TEST_ASSERT_EQUAL(2, accepted - acceptedBefore);
+}
+
+void test_refused_connect_is_reported_once() {
+    ConfigManager::API_BASE_URL = closedUrl;
+    uint32_t connectsBefore = LatencyStats::getCount(LatencyStats::CONNECT_STAGE);
+    unsigned long newBefore = ApiClient::getNewConnections();
+    
+    ScanResult result = ApiClient::scanUser(7);
+    
+    TEST_ASSERT_FALSE(result.success);
+    TEST_ASSERT_EQUAL(API_CONNECTION_REFUSED, result.error);
+    TEST_ASSERT_EQUAL(1, (int)(ApiClient::getNewConnections() - newBefore));
+    TEST_ASSERT_EQUAL(connectsBefore, LatencyStats::getCount(LatencyStats::CONNECT_STAGE));
+}
+
+void test_https_is_rejected_before_connecting() {
+    // Сервер слухає, але TLS клієнт не вміє, тож до нього не йде навіть SYN
+    serve(okResponse("[]"), false);
+    ConfigManager::API_BASE_URL = httpsUrl;
+    int acceptedBefore = accepted;
+    
+    TEST_ASSERT_FALSE(ApiClient::probeApi());
+    TEST_ASSERT_EQUAL(0, accepted - acceptedBefore);
+}
+
+// ============================================================================
+// Потоковий розбір
+// ============================================================================
+void test_leaderboard_parsed_from_chunked_socket() {
+    serve(chunkedResponse("[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\",\"teamPoints\":10,"
+                          "\"teamLevel\":\"Gold\",\"avatarUrl\":\"http://example/a.png\"},"
+                          "{\"rank\":2,\"userId\":9,\"fullName\":\"Bob\",\"teamPoints\":5}]"), false);
+    int acceptedBefore = accepted;
+    LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+    
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UPDATED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_EQUAL(7, entries[0].userId);
+    TEST_ASSERT_EQUAL_STRING("Ann", entries[0].fullName.c_str());
+    TEST_ASSERT_EQUAL_STRING("Gold", entries[0].teamLevel.c_str());
+    TEST_ASSERT_EQUAL(9, entries[1].userId);
+    TEST_ASSERT_EQUAL(0, entries[2].userId);
+    
+    // Тіло дочитане до останнього чанку, тож сокет іде на наступний запит
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    TEST_ASSERT_EQUAL(1, accepted - acceptedBefore);
+}
+
+// Тіло довше за буфер попереднього читання: решта розбирається з сокета,
+// а поля поза фільтром не займають пул
+void test_long_leaderboard_fits_parse_pool() {
+    std::string body = "[";
+    for (int i = 0; i < LONG_LEADERBOARD_ENTRIES; i++) {
+        if (i > 0) body += ",";
+        body += "{\"rank\":" + std::to_string(i + 1) + ",\"userId\":" + std::to_string(100 + i) +
+                ",\"fullName\":\"Participant Name\",\"teamPoints\":" + std::to_string(20000 - i) +
+                ",\"teamLevel\":\"Silver\",\"avatarUrl\":\"http://example/avatars/" +
+                std::to_string(i) + ".png\",\"teamName\":\"Stair Climbers\"}";
+    }
+    body += "]";
+    TEST_ASSERT_GREATER_THAN(Parsing::LEADERBOARD_BODY_LENGTH, body.size());
+    
+    serve(chunkedResponse(body), false);
+    LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UPDATED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_EQUAL(100, entries[0].userId);
+    TEST_ASSERT_EQUAL(104, entries[Display::MAX_LEADERBOARD_ENTRIES - 1].userId);
+    TEST_ASSERT_EQUAL(body.size(), ApiClient::getLastBodyBytes());
+    TEST_ASSERT_LESS_OR_EQUAL(ApiClient::getParsePoolCapacity(), ApiClient::getParsePoolPeak());
+}
+
+// ============================================================================
+// Незмінний лідерборд
+// ============================================================================
+void test_identical_leaderboard_is_not_parsed() {
+    // Без ETag: сервер щоразу віддає тіло повністю
+    std::string body = "[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\",\"teamPoints\":10}]";
+    serve(okResponse(body), false);
+    LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+    unsigned long updatedBytes = ApiClient::getUpdatedBytes();
+    
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UPDATED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_EQUAL(body.size(), ApiClient::getUpdatedBytes() - updatedBytes);
+    unsigned long unparsedBefore = ApiClient::getUnparsedResponses();
+    unsigned long identicalBytes = ApiClient::getIdenticalBytes();
+    unsigned long parseMicros = ApiClient::getLastParseMicros();
+    
+    entries[0] = LeaderboardEntry();
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UNCHANGED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_EQUAL(1, (int)(ApiClient::getUnparsedResponses() - unparsedBefore));
+    TEST_ASSERT_EQUAL(body.size(), ApiClient::getIdenticalBytes() - identicalBytes);
+    TEST_ASSERT_EQUAL(parseMicros, ApiClient::getLastParseMicros());
+    
+    // Екран отримує збережену таблицю
+    TEST_ASSERT_EQUAL(7, entries[0].userId);
+    
+    serve(okResponse("[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\",\"teamPoints\":11}]"), false);
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UPDATED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_EQUAL(11, entries[0].teamPoints);
+}
+
+void test_not_modified_counts_the_last_body_as_saved() {
+    std::string body = "[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\",\"teamPoints\":10}]";
+    serve("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nETag: \"v1\"\r\nContent-Length: " +
+          std::to_string(body.size()) + "\r\n\r\n" + body, false);
+    LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UPDATED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    unsigned long notModifiedBytes = ApiClient::getNotModifiedBytes();
+    unsigned long identicalBytes = ApiClient::getIdenticalBytes();
+    
+    serve("HTTP/1.1 304 Not Modified\r\nETag: \"v1\"\r\nContent-Length: 0\r\n\r\n", false);
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UNCHANGED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_EQUAL(body.size(), ApiClient::getNotModifiedBytes() - notModifiedBytes);
+    TEST_ASSERT_EQUAL(identicalBytes, ApiClient::getIdenticalBytes());
+}
+
+// ============================================================================
+// MessagePack
+// ============================================================================
+void test_msgpack_profile_is_smaller_and_parsed() {
+    // Профіль із WireBenchmark
+    JsonDocument doc;
+    doc["userId"] = 42;
+    doc["teamId"] = 7;
+    doc["fullName"] = "Olena Kovalenko";
+    doc["teamPoints"] = 12840;
+    doc["teamLevelName"] = "Gold";
+    JsonArray badges = doc["recentBadges"].to<JsonArray>();
+    badges.add("Early Bird");
+    badges.add("Stair Master");
+    badges.add("Team Player");
+    
+    std::string json;
+    std::string msgPack;
+    serializeJson(doc, json);
+    serializeMsgPack(doc, msgPack);
+    TEST_ASSERT_LESS_THAN(json.size(), msgPack.size());
+    
+    serve(okResponse(msgPack, "application/msgpack"), false);
+    unsigned long msgPackBefore = ApiClient::getMsgPackResponses();
+    ScanResult result = ApiClient::scanUser(42);
+    
+    TEST_ASSERT_TRUE(result.success);
+    TEST_ASSERT_EQUAL(12840, result.teamPoints);
+    TEST_ASSERT_EQUAL_STRING("Olena Kovalenko", result.fullName.c_str());
+    TEST_ASSERT_EQUAL(3, result.badgeCount);
+    TEST_ASSERT_EQUAL_STRING("Team Player", result.recentBadges[2].c_str());
+    TEST_ASSERT_EQUAL(1, (int)(ApiClient::getMsgPackResponses() - msgPackBefore));
+    TEST_ASSERT_EQUAL(msgPack.size(), ApiClient::getLastBodyBytes());
+    
+    // Бекенд відповів MessagePack, тож і наступний запит піде в ньому
+    TEST_ASSERT_EQUAL_STRING("msgpack", ApiClient::getSendFormat());
+}
+
+// ============================================================================
+// Купа
+// ============================================================================
+void test_steady_state_keeps_heap_watermark() {
+    // Перший запит відкриває сокет і виділяє буфери HTTPClient, перша
+    // таблиця заповнює кеш; далі запити дашборду не мають займати купу
+    serve(okResponse("[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\",\"teamPoints\":10}]"), false);
+    LeaderboardEntry entries[Display::MAX_LEADERBOARD_ENTRIES];
+    TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UPDATED,
+                      ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+    TEST_ASSERT_TRUE(ApiClient::probeApi());
+    uint32_t freeAfterWarmup = ESP.getFreeHeap();
+    uint32_t watermark = ESP.getMinFreeHeap();
+    
+    for (int i = 0; i < STEADY_REQUESTS; i++) {
+        TEST_ASSERT_EQUAL(ApiClient::LEADERBOARD_UNCHANGED,
+                          ApiClient::getLeaderboard(entries, Display::MAX_LEADERBOARD_ENTRIES));
+        TEST_ASSERT_TRUE(ApiClient::probeApi());
+        TEST_ASSERT_EQUAL_UINT32(freeAfterWarmup, ESP.getFreeHeap());
+    }
+    TEST_ASSERT_EQUAL_UINT32(watermark, ESP.getMinFreeHeap());
+}
+
+int main(int argc, char** argv) {
+    startServer();
+    reserveClosedPort();
+    ConfigManager::initialize();
+    ConfigManager::API_BASE_URL = baseUrl;
+    
+    WiFiManager::begin();
+    unsigned long start = millis();
+    while (!WiFiManager::isConnected() && millis() - start < WIFI_WAIT_MS) delay(1);
+    
+    UNITY_BEGIN();
+    RUN_TEST(test_requests_share_one_connection);
+    RUN_TEST(test_unread_body_does_not_break_next_request);
+    RUN_TEST(test_reconnects_after_server_closes);
+    RUN_TEST(test_refused_connect_is_reported_once);
+    RUN_TEST(test_https_is_rejected_before_connecting);
+    RUN_TEST(test_leaderboard_parsed_from_chunked_socket);
+    RUN_TEST(test_long_leaderboard_fits_parse_pool);
+    RUN_TEST(test_identical_leaderboard_is_not_parsed);
+    RUN_TEST(test_not_modified_counts_the_last_body_as_saved);
+    RUN_TEST(test_msgpack_profile_is_smaller_and_parsed);
+    RUN_TEST(test_steady_state_keeps_heap_watermark);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <unity.h>
+#include "modules/badge_directory.h"
+
+// ============================================================================
+// BadgeDirectory: пошук у таблиці з флешу, кеш відповідей сервера,
+// час пошуку й пам'ять
+// ============================================================================
+// Таблиця — та, що згенерована в src/badge_table.h, тож тести проходять
+// по її слотах, а не по конкретних картках
+namespace {
+    const int TIMED_LOOKUPS = 100000;
+    const unsigned long MAX_AVERAGE_LOOKUP_NS = 1000;
+    const unsigned int MAX_LOAD_PERCENT = 75; // як у tools/gen_badge_table.py
+    
+    const uint8_t ABSENT_UID[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    
+    uint64_t absentKey() {
+        return BadgeDirectory::makeKey(ABSENT_UID, sizeof(ABSENT_UID));
+    }
+    
+    uint64_t cardKey(uint8_t index) {
+        const uint8_t uid[] = { 0x08, 0x00, 0x00, index };
+        return BadgeDirectory::makeKey(uid, sizeof(uid));
+    }
+}
+
+void setUp() {
+    Preferences prefs;
+    prefs.begin("badges", false);
+    prefs.clear();
+    prefs.end();
+    BadgeDirectory::initialize();
+}
+
+void tearDown() {}
+
+void test_every_table_card_resolves() {
+    for (unsigned int i = 0; i < BadgeTable::SLOT_COUNT; i++) {
+        if (BadgeTable::KEYS[i] == 0) continue;
+        TEST_ASSERT_EQUAL((int)BadgeTable::USER_IDS[i], BadgeDirectory::lookup(BadgeTable::KEYS[i]));
+    }
+}
+
+void test_absent_card_goes_to_server() {
+    unsigned long missesBefore = BadgeDirectory::getMisses();
+    
+    TEST_ASSERT_EQUAL(0, BadgeDirectory::lookup(absentKey()));
+    TEST_ASSERT_EQUAL(1, (int)(BadgeDirectory::getMisses() - missesBefore));
+}
+
+void test_server_answer_is_cached() {
+    BadgeDirectory::remember(absentKey(), 42);
+    unsigned long cacheHitsBefore = BadgeDirectory::getCacheHits();
+    
+    TEST_ASSERT_EQUAL(42, BadgeDirectory::lookup(absentKey()));
+    TEST_ASSERT_EQUAL(1, (int)(BadgeDirectory::getCacheHits() - cacheHitsBefore));
+}
+
+void test_only_known_users_survive_restart() {
+    BadgeDirectory::remember(cardKey(1), 42);
+    BadgeDirectory::remember(cardKey(2), BadgeDirectory::UNKNOWN_CARD);
+    TEST_ASSERT_EQUAL(BadgeDirectory::UNKNOWN_CARD, BadgeDirectory::lookup(cardKey(2)));
+    
+    BadgeDirectory::initialize();
+    
+    TEST_ASSERT_EQUAL(42, BadgeDirectory::lookup(cardKey(1)));
+    TEST_ASSERT_EQUAL(0, BadgeDirectory::lookup(cardKey(2)));
+}
+
+void test_cache_replaces_oldest_card() {
+    for (int i = 0; i <= Badges::CARD_CACHE_SIZE; i++) {
+        BadgeDirectory::remember(cardKey(i), 100 + i);
+    }
+    
+    TEST_ASSERT_EQUAL(0, BadgeDirectory::lookup(cardKey(0)));
+    TEST_ASSERT_EQUAL(101, BadgeDirectory::lookup(cardKey(1)));
+    TEST_ASSERT_EQUAL(100 + Badges::CARD_CACHE_SIZE, BadgeDirectory::lookup(cardKey(Badges::CARD_CACHE_SIZE)));
+}
+
+void test_key_round_trips_uid() {
+    const uint8_t uid[] = { 0x04, 0xA1, 0xB2, 0xC3, 0x5D, 0x6E, 0x7F };
+    UidText text;
+    
+    BadgeDirectory::formatUid(BadgeDirectory::makeKey(uid, sizeof(uid)), text);
+    TEST_ASSERT_EQUAL_STRING("04A1B2C35D6E7F", text.c_str());
+    
+    // Довжина — частина ключа: 4-байтовий UID не збігається з 7-байтовим
+    TEST_ASSERT_NOT_EQUAL(BadgeDirectory::makeKey(uid, 4), BadgeDirectory::makeKey(uid, 7));
+    TEST_ASSERT_EQUAL(0, BadgeDirectory::makeKey(uid, 0));
+    TEST_ASSERT_EQUAL(0, BadgeDirectory::makeKey(uid, Badges::MAX_UID_LENGTH + 1));
+}
+
+// Присутні й відсутні картки навпереміну; зондування обох не довше
+// за MAX_PROBE слотів, тож середнє тримається й на великій таблиці
+void test_lookup_time() {
+    uint64_t presentKey = absentKey();
+    for (unsigned int i = 0; i < BadgeTable::SLOT_COUNT; i++) {
+        if (BadgeTable::KEYS[i] != 0) presentKey = BadgeTable::KEYS[i];
+    }
+    
+    unsigned long start = micros();
+    for (int i = 0; i < TIMED_LOOKUPS; i++) {
+        BadgeDirectory::lookup((i & 1) ? presentKey : absentKey());
+    }
+    unsigned long averageNs = (micros() - start) * 1000UL / TIMED_LOOKUPS;
+    
+    char message[96];
+    snprintf(message, sizeof(message), "lookup avg=%luns cards=%u slots=%u max_probe=%u",
+             averageNs, BadgeTable::CARD_COUNT, BadgeTable::SLOT_COUNT, BadgeTable::MAX_PROBE);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(MAX_AVERAGE_LOOKUP_NS, averageNs);
+}
+
+void test_memory_footprint() {
+    unsigned int tableBytes = BadgeDirectory::getTableBytes();
+    unsigned int cacheBytes = BadgeDirectory::getCacheBytes();
+    
+    char message[96];
+    snprintf(message, sizeof(message), "table=%uB (flash) cache=%uB (RAM, NVS) per_slot=%uB",
+             tableBytes, cacheBytes, tableBytes / BadgeTable::SLOT_COUNT);
+    TEST_MESSAGE(message);
+    
+    // Слот — ключ і userId без вказівників; маска індексу вимагає степеня двійки
+    TEST_ASSERT_EQUAL(BadgeTable::SLOT_COUNT * (sizeof(uint64_t) + sizeof(uint32_t)), tableBytes);
+    TEST_ASSERT_EQUAL(0, BadgeTable::SLOT_COUNT & (BadgeTable::SLOT_COUNT - 1));
+    TEST_ASSERT_LESS_OR_EQUAL(BadgeTable::SLOT_COUNT * MAX_LOAD_PERCENT, BadgeTable::CARD_COUNT * 100);
+    TEST_ASSERT_LESS_OR_EQUAL(Badges::CARD_CACHE_SIZE * 16, cacheBytes);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_table_card_resolves);
+    RUN_TEST(test_absent_card_goes_to_server);
+    RUN_TEST(test_server_answer_is_cached);
+    RUN_TEST(test_only_known_users_survive_restart);
+    RUN_TEST(test_cache_replaces_oldest_card);
+    RUN_TEST(test_key_round_trips_uid);
+    RUN_TEST(test_lookup_time);
+    RUN_TEST(test_memory_footprint);
+    return UNITY_END();
+}
@@ -0,0 +1,115 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "native_hal.h"
+#include "modules/config_manager.h"
+#include "modules/wifi_manager.h"
+#include "modules/network_worker.h"
+#include "modules/dashboard_poller.h"
+#include "modules/scheduler.h"
+#include "modules/profile_cache.h"
+#include "modules/badge_reader.h"
+#include "modules/core_logic.h"
+
+// ============================================================================
+// CoreLogic: що з'являється на екрані до відповіді бекенду
+// ============================================================================
+// Бекенд приймає з'єднання, але не відповідає, тож поставлені запити
+// лишаються в дорозі, а тест дивиться, що CoreLogic поставив і які
+// таймери лишив
+namespace {
+    const unsigned long WIFI_WAIT_MS = 1000;
+    
+    char baseUrl[32];
+    
+    void startSilentServer() {
+        int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenFd, (sockaddr*)&address, sizeof(address));
+        listen(listenFd, 8);
+        
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, (sockaddr*)&address, &length);
+        snprintf(baseUrl, sizeof(baseUrl), "http://127.0.0.1:%u", ntohs(address.sin_port));
+    }
+    
+    void pressButton(int pin) {
+        NativeHal::setPinLevel(pin, LOW);
+        NativeHal::setPinLevel(pin, HIGH);
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_dashboard_polls_as_soon_as_wifi_is_up() {
+    ConfigManager::currentMode = ConfigManager::DASHBOARD_MODE;
+    CoreLogic::start();
+    TEST_ASSERT_TRUE(Scheduler::isArmed(Scheduler::DASHBOARD_TIMER));
+    unsigned long pollsBefore = DashboardPoller::getPolls();
+    
+    WiFiManager::begin();
+    unsigned long start = millis();
+    while (!WiFiManager::isConnected() && millis() - start < WIFI_WAIT_MS) delay(1);
+    TEST_ASSERT_TRUE(WiFiManager::isConnected());
+    
+    // Підключення обробляє перший же прохід loop(), до дедлайну таймера
+    CoreLogic::run();
+    
+    TEST_ASSERT_EQUAL(1, (int)(DashboardPoller::getPolls() - pollsBefore));
+    TEST_ASSERT_FALSE(Scheduler::isArmed(Scheduler::DASHBOARD_TIMER));
+    
+    // Разом із таблицею в дорозі перевірка API
+    TEST_ASSERT_EQUAL(2, CoreLogic::getPendingRequests());
+}
+
+void test_cached_profile_is_drawn_before_the_response() {
+    ConfigManager::currentMode = ConfigManager::SCAN_MODE;
+    ScanResult profile;
+    profile.userId = Users::USER1_ID;
+    profile.fullName = Users::USER1_NAME;
+    profile.success = true;
+    ProfileCache::store(profile);
+    unsigned long hitsBefore = ProfileCache::getHits();
+    int pendingBefore = CoreLogic::getPendingRequests();
+    
+    pressButton(Hardware::BUTTON_USER1);
+    CoreLogic::run();
+    
+    // Запит ще в дорозі, а на екрані вже профіль із кешу
+    TEST_ASSERT_EQUAL(pendingBefore + 1, CoreLogic::getPendingRequests());
+    TEST_ASSERT_EQUAL(CoreLogic::SCANNING_STATE, CoreLogic::getUiState());
+    TEST_ASSERT_EQUAL(RetainedScreen::PROFILE_SCREEN, RetainedScreen::getCurrentScreen());
+    TEST_ASSERT_EQUAL(1, (int)(ProfileCache::getHits() - hitsBefore));
+}
+
+void test_uncached_profile_waits_for_the_response() {
+    ConfigManager::currentMode = ConfigManager::SCAN_MODE;
+    unsigned long missesBefore = ProfileCache::getMisses();
+    
+    pressButton(Hardware::BUTTON_USER2);
+    CoreLogic::run();
+    
+    TEST_ASSERT_EQUAL(RetainedScreen::SCANNING_SCREEN, RetainedScreen::getCurrentScreen());
+    TEST_ASSERT_EQUAL(1, (int)(ProfileCache::getMisses() - missesBefore));
+}
+
+int main(int argc, char** argv) {
+    startSilentServer();
+    ConfigManager::initialize();
+    ConfigManager::API_BASE_URL = baseUrl;
+    Scheduler::begin();
+    NetworkWorker::start();
+    BadgeReader::initialize();
+    
+    UNITY_BEGIN();
+    RUN_TEST(test_dashboard_polls_as_soon_as_wifi_is_up);
+    RUN_TEST(test_cached_profile_is_drawn_before_the_response);
+    RUN_TEST(test_uncached_profile_waits_for_the_response);
+    return UNITY_END();
+}
@@ -0,0 +1,109 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "fixed_string.h"
+
+// ============================================================================
+// FixedString: межа ємності та прапорець обрізання
+// ============================================================================
+void setUp() {}
+
+void tearDown() {}
+
+void test_short_text_is_kept() {
+    FixedString<8> text("Ann");
+    
+    TEST_ASSERT_EQUAL_STRING("Ann", text.c_str());
+    TEST_ASSERT_EQUAL(3, text.length());
+    TEST_ASSERT_FALSE(text.isTruncated());
+}
+
+void test_text_of_exact_capacity_is_not_truncated() {
+    FixedString<4> text("abcd");
+    
+    TEST_ASSERT_EQUAL_STRING("abcd", text.c_str());
+    TEST_ASSERT_FALSE(text.isTruncated());
+}
+
+void test_long_text_is_cut_at_capacity() {
+    FixedString<4> text("abcdef");
+    
+    TEST_ASSERT_EQUAL_STRING("abcd", text.c_str());
+    TEST_ASSERT_EQUAL(4, text.length());
+    TEST_ASSERT_TRUE(text.isTruncated());
+}
+
+void test_append_stops_at_capacity() {
+    FixedString<4> text("ab");
+    text.append("cdef");
+    
+    TEST_ASSERT_EQUAL_STRING("abcd", text.c_str());
+    TEST_ASSERT_TRUE(text.isTruncated());
+}
+
+void test_assign_clears_truncation() {
+    FixedString<4> text("abcdef");
+    text = "xy";
+    
+    TEST_ASSERT_EQUAL_STRING("xy", text.c_str());
+    TEST_ASSERT_FALSE(text.isTruncated());
+}
+
+void test_assign_takes_prefix() {
+    FixedString<16> host;
+    host.assign("example.org:8080", 11);
+    
+    TEST_ASSERT_EQUAL_STRING("example.org", host.c_str());
+    TEST_ASSERT_EQUAL(11, host.length());
+}
+
+void test_null_is_ignored() {
+    FixedString<4> text("ab");
+    text.append(nullptr);
+    
+    TEST_ASSERT_EQUAL_STRING("ab", text.c_str());
+}
+
+void test_format_fits() {
+    FixedString<16> text;
+    text.format("#%d %s", 3, "Ann");
+    
+    TEST_ASSERT_EQUAL_STRING("#3 Ann", text.c_str());
+    TEST_ASSERT_FALSE(text.isTruncated());
+}
+
+void test_format_is_cut_at_capacity() {
+    FixedString<6> text;
+    text.format("%d-%s", 12345, "xyz");
+    
+    TEST_ASSERT_EQUAL_STRING("12345-", text.c_str());
+    TEST_ASSERT_EQUAL(6, text.length());
+    TEST_ASSERT_TRUE(text.isTruncated());
+}
+
+void test_compares_with_text() {
+    FixedString<8> text("Gold");
+    
+    TEST_ASSERT_TRUE(text == "Gold");
+    TEST_ASSERT_TRUE(text != "Silver");
+}
+
+void test_storage_is_inline() {
+    // Буфер, довжина, прапорець і вирівнювання — і нічого в купі
+    TEST_ASSERT_LESS_THAN(32 + 8, sizeof(FixedString<32>));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_short_text_is_kept);
+    RUN_TEST(test_text_of_exact_capacity_is_not_truncated);
+    RUN_TEST(test_long_text_is_cut_at_capacity);
+    RUN_TEST(test_append_stops_at_capacity);
+    RUN_TEST(test_assign_clears_truncation);
+    RUN_TEST(test_assign_takes_prefix);
+    RUN_TEST(test_null_is_ignored);
+    RUN_TEST(test_format_fits);
+    RUN_TEST(test_format_is_cut_at_capacity);
+    RUN_TEST(test_compares_with_text);
+    RUN_TEST(test_storage_is_inline);
+    return UNITY_END();
+}
@@ -0,0 +1,159 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <unity.h>
+#include <string>
+#include "modules/http_body_stream.h"
+
+// ============================================================================
+// HttpBodyStream на байтах, що вже лежать у сокеті
+// ============================================================================
+// Після тіла в сокеті навмисно лежить початок наступної відповіді:
+// потік не має його зачепити, інакше keep-alive зламається
+namespace {
+    const char NEXT_RESPONSE[] = "HTTP/1.1 200 OK\r\n";
+    const char BODY[] = "[{\"rank\":1,\"userId\":7,\"fullName\":\"Ann\"}]";
+    
+    class MemoryStream : public Stream {
+    private:
+        std::string data;
+        size_t position;
+        
+    public:
+        explicit MemoryStream(const std::string& text) : data(text), position(0) {
+            setTimeout(0);
+        }
+        
+        int available() override { return (int)(data.size() - position); }
+        int read() override { return position < data.size() ? (uint8_t)data[position++] : -1; }
+        int peek() override { return position < data.size() ? (uint8_t)data[position] : -1; }
+        size_t write(uint8_t) override { return 0; }
+        
+        std::string rest() const { return data.substr(position); }
+    };
+    
+    // Тіло BODY, розбите на чанки посеред рядка й із розширенням чанку
+    std::string chunkedBody() {
+        return "9\r\n[{\"rank\":\r\n"
+               "14;name=value\r\n1,\"userId\":7,\"fullNa\r\n"
+               "b\r\nme\":\"Ann\"}]\r\n"
+               "0\r\n\r\n";
+    }
+    
+    std::string readAll(HttpBodyStream& body) {
+        std::string text;
+        int c;
+        while ((c = body.read()) >= 0) text += (char)c;
+        return text;
+    }
+    
+    uint32_t fnv1a(const char* text) {
+        uint32_t hash = 2166136261UL;
+        for (; *text != '\0'; text++) hash = (hash ^ (uint8_t)*text) * 16777619UL;
+        return hash;
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_reads_exactly_content_length() {
+    MemoryStream socket(std::string(BODY) + NEXT_RESPONSE);
+    HttpBodyStream body(socket, strlen(BODY), false);
+    
+    TEST_ASSERT_EQUAL_STRING(BODY, readAll(body).c_str());
+    TEST_ASSERT_EQUAL(strlen(BODY), body.getBytesRead());
+    TEST_ASSERT_EQUAL_STRING(NEXT_RESPONSE, socket.rest().c_str());
+}
+
+void test_decodes_chunks_split_mid_token() {
+    MemoryStream socket(chunkedBody() + NEXT_RESPONSE);
+    HttpBodyStream body(socket, -1, true);
+    
+    TEST_ASSERT_EQUAL_STRING(BODY, readAll(body).c_str());
+    TEST_ASSERT_EQUAL_STRING(NEXT_RESPONSE, socket.rest().c_str());
+}
+
+void test_peek_does_not_consume() {
+    MemoryStream socket(chunkedBody());
+    HttpBodyStream body(socket, -1, true);
+    
+    TEST_ASSERT_EQUAL('[', body.peek());
+    TEST_ASSERT_EQUAL('[', body.read());
+    TEST_ASSERT_EQUAL('{', body.read());
+}
+
+void test_drain_skips_unread_body() {
+    MemoryStream socket(chunkedBody() + NEXT_RESPONSE);
+    HttpBodyStream body(socket, -1, true);
+    
+    char head[4];
+    TEST_ASSERT_EQUAL(sizeof(head), body.readInto(head, sizeof(head)));
+    body.drain();
+    
+    TEST_ASSERT_EQUAL(strlen(BODY), body.getBytesRead());
+    TEST_ASSERT_EQUAL_STRING(NEXT_RESPONSE, socket.rest().c_str());
+}
+
+void test_hash_covers_body_only() {
+    MemoryStream plainSocket(std::string(BODY) + NEXT_RESPONSE);
+    HttpBodyStream plain(plainSocket, strlen(BODY), false);
+    plain.drain();
+    
+    MemoryStream chunkedSocket(chunkedBody() + NEXT_RESPONSE);
+    HttpBodyStream chunked(chunkedSocket, -1, true);
+    chunked.drain();
+    
+    // Розмітка чанків у хеш не потрапляє
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(BODY), plain.getContentHash());
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(BODY), chunked.getContentHash());
+}
+
+void test_prefetch_knows_hash_before_reading() {
+    MemoryStream socket(chunkedBody() + NEXT_RESPONSE);
+    HttpBodyStream body(socket, -1, true);
+    char buffer[64];
+    
+    TEST_ASSERT_TRUE(body.prefetch(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(BODY), body.getContentHash());
+    TEST_ASSERT_EQUAL_STRING(NEXT_RESPONSE, socket.rest().c_str());
+    TEST_ASSERT_EQUAL_STRING(BODY, readAll(body).c_str());
+}
+
+void test_prefetch_of_long_body_continues_from_socket() {
+    MemoryStream socket(chunkedBody() + NEXT_RESPONSE);
+    HttpBodyStream body(socket, -1, true);
+    char buffer[10];
+    
+    TEST_ASSERT_FALSE(body.prefetch(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL('[', body.peek());
+    TEST_ASSERT_EQUAL_STRING(BODY, readAll(body).c_str());
+    TEST_ASSERT_EQUAL_HEX32(fnv1a(BODY), body.getContentHash());
+    TEST_ASSERT_EQUAL_STRING(NEXT_RESPONSE, socket.rest().c_str());
+}
+
+void test_parser_reads_chunked_body_in_place() {
+    MemoryStream socket(chunkedBody() + NEXT_RESPONSE);
+    HttpBodyStream body(socket, -1, true);
+    
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(deserializeJson(doc, body) == DeserializationError::Ok);
+    body.drain();
+    
+    TEST_ASSERT_EQUAL(7, doc[0]["userId"].as<int>());
+    TEST_ASSERT_EQUAL_STRING("Ann", doc[0]["fullName"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING(NEXT_RESPONSE, socket.rest().c_str());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_exactly_content_length);
+    RUN_TEST(test_decodes_chunks_split_mid_token);
+    RUN_TEST(test_peek_does_not_consume);
+    RUN_TEST(test_drain_skips_unread_body);
+    RUN_TEST(test_hash_covers_body_only);
+    RUN_TEST(test_prefetch_knows_hash_before_reading);
+    RUN_TEST(test_prefetch_of_long_body_continues_from_socket);
+    RUN_TEST(test_parser_reads_chunked_body_in_place);
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "native_hal.h"
+#include "modules/input_events.h"
+
+// ============================================================================
+// InputEvents: переривання за рівнем, що заразом будять light sleep
+// ============================================================================
+// Рівні на лініях задає NativeHal::setPinLevel(), як сценарій натискань
+namespace {
+    const int BUTTON_PIN = Hardware::BUTTON_USER1;
+    const int IRQ_PIN = Hardware::RFID_IRQ;
+    
+    int drainEvents() {
+        InputEvent event;
+        int count = 0;
+        while (InputEvents::poll(event)) count++;
+        return count;
+    }
+}
+
+void setUp() {
+    NativeHal::setPinLevel(BUTTON_PIN, HIGH);
+    NativeHal::setPinLevel(IRQ_PIN, HIGH);
+    InputEvents::attach(BUTTON_PIN, InputEvents::BADGE_BUTTON_1);
+    InputEvents::attachIrq(IRQ_PIN, InputEvents::RFID_CARD);
+    drainEvents();
+}
+
+void tearDown() {}
+
+void test_press_gives_one_event() {
+    NativeHal::setPinLevel(BUTTON_PIN, LOW);
+    NativeHal::setPinLevel(BUTTON_PIN, HIGH);
+    
+    InputEvent event;
+    TEST_ASSERT_TRUE(InputEvents::poll(event));
+    TEST_ASSERT_EQUAL(InputEvents::BADGE_BUTTON_1, event.source);
+    TEST_ASSERT_FALSE(InputEvents::poll(event));
+}
+
+void test_bounce_is_coalesced() {
+    unsigned long coalescedBefore = InputEvents::getCoalescedEvents();
+    
+    NativeHal::setPinLevel(BUTTON_PIN, LOW);
+    NativeHal::setPinLevel(BUTTON_PIN, HIGH);
+    NativeHal::setPinLevel(BUTTON_PIN, LOW);
+    NativeHal::setPinLevel(BUTTON_PIN, HIGH);
+    
+    TEST_ASSERT_EQUAL(1, drainEvents());
+    TEST_ASSERT_EQUAL(1, (int)(InputEvents::getCoalescedEvents() - coalescedBefore));
+}
+
+void test_held_button_does_not_repeat() {
+    // Після натискання лінія чекає на високий рівень, тож утримання
+    // не дає нових переривань
+    NativeHal::setPinLevel(BUTTON_PIN, LOW);
+    delay(Timing::BUTTON_DEBOUNCE_MS + 50);
+    TEST_ASSERT_EQUAL(1, drainEvents());
+    
+    NativeHal::setPinLevel(BUTTON_PIN, HIGH);
+    delay(Timing::BUTTON_SETTLE_MS + 10);
+    NativeHal::setPinLevel(BUTTON_PIN, LOW);
+    NativeHal::setPinLevel(BUTTON_PIN, HIGH);
+    TEST_ASSERT_EQUAL(1, drainEvents());
+}
+
+void test_every_irq_assertion_is_a_card() {
+    NativeHal::setPinLevel(IRQ_PIN, LOW);
+    NativeHal::setPinLevel(IRQ_PIN, HIGH);
+    NativeHal::setPinLevel(IRQ_PIN, LOW);
+    NativeHal::setPinLevel(IRQ_PIN, HIGH);
+    
+    InputEvent event;
+    TEST_ASSERT_TRUE(InputEvents::poll(event));
+    TEST_ASSERT_EQUAL(InputEvents::RFID_CARD, event.source);
+    TEST_ASSERT_TRUE(InputEvents::poll(event));
+    TEST_ASSERT_FALSE(InputEvents::poll(event));
+}
+
+void test_wake_timestamp_is_peeked_in_place() {
+    uint32_t before = (uint32_t)esp_timer_get_time();
+    NativeHal::setPinLevel(IRQ_PIN, LOW);
+    NativeHal::setPinLevel(IRQ_PIN, HIGH);
+    uint32_t after = (uint32_t)esp_timer_get_time();
+    
+    uint32_t wokeAt;
+    TEST_ASSERT_TRUE(InputEvents::peekTimestamp(wokeAt));
+    TEST_ASSERT_TRUE(wokeAt - before <= after - before);
+    
+    InputEvent event;
+    TEST_ASSERT_TRUE(InputEvents::poll(event));
+    TEST_ASSERT_EQUAL_UINT32(wokeAt, event.timestampUs);
+    TEST_ASSERT_FALSE(InputEvents::peekTimestamp(wokeAt));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_press_gives_one_event);
+    RUN_TEST(test_bounce_is_coalesced);
+    RUN_TEST(test_held_button_does_not_repeat);
+    RUN_TEST(test_every_irq_assertion_is_a_card);
+    RUN_TEST(test_wake_timestamp_is_peeked_in_place);
+    return UNITY_END();
+}
@@ -0,0 +1,136 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "modules/config_manager.h"
+#include "modules/wifi_manager.h"
+#include "modules/leaderboard_stream.h"
+
+// ============================================================================
+// LeaderboardStream проти бекенду без SSE-ендпойнта
+// ============================================================================
+// Сервер відповідає на кожен запит заданим статусом і закриває сокет,
+// а тест рахує, скільки разів потік пробував підключитися
+namespace {
+    const unsigned long WIFI_WAIT_MS = 1000;
+    
+    int listenFd = -1;
+    char baseUrl[32];
+    std::atomic<int> status(404);
+    std::atomic<int> accepted(0);
+    
+    void serveConnection(int fd) {
+        char buffer[512];
+        std::string request;
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+            if (length <= 0) break;
+            request.append(buffer, length);
+        }
+        
+        std::string text = "HTTP/1.1 " + std::to_string(status.load()) +
+                           " Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+        ::close(fd);
+    }
+    
+    void acceptLoop() {
+        for (;;) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;
+            accepted++;
+            std::thread(serveConnection, fd).detach();
+        }
+    }
+    
+    void startServer() {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenFd, (sockaddr*)&address, sizeof(address));
+        listen(listenFd, 8);
+        
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, (sockaddr*)&address, &length);
+        snprintf(baseUrl, sizeof(baseUrl), "http://127.0.0.1:%u", ntohs(address.sin_port));
+        std::thread(acceptLoop).detach();
+    }
+    
+    // Кілька проходів мережевої задачі поспіль. Пауза між спробами довша
+    // за прогін, тож друга спроба означала б, що паузи немає
+    int serviceAttempts(int passes) {
+        int acceptedBefore = accepted;
+        for (int i = 0; i < passes; i++) {
+            LeaderboardStream::service();
+        }
+        return accepted - acceptedBefore;
+    }
+}
+
+void setUp() {
+    LeaderboardStream::reset();
+}
+
+void tearDown() {}
+
+void test_missing_endpoint_stops_retries() {
+    status = 404;
+    
+    TEST_ASSERT_EQUAL(1, serviceAttempts(5));
+    TEST_ASSERT_TRUE(LeaderboardStream::isUnsupported());
+    TEST_ASSERT_FALSE(LeaderboardStream::isActive());
+}
+
+void test_not_implemented_stops_retries() {
+    status = 501;
+    
+    TEST_ASSERT_EQUAL(1, serviceAttempts(5));
+    TEST_ASSERT_TRUE(LeaderboardStream::isUnsupported());
+}
+
+void test_server_error_backs_off() {
+    status = 503;
+    
+    TEST_ASSERT_EQUAL(1, serviceAttempts(5));
+    TEST_ASSERT_FALSE(LeaderboardStream::isUnsupported());
+    TEST_ASSERT_TRUE(LeaderboardStream::isActive());
+    
+    // Наступна невдача чекатиме вдвічі довше
+    TEST_ASSERT_EQUAL(2 * Timing::STREAM_RETRY_MS, LeaderboardStream::getRetryMs());
+}
+
+void test_backend_change_retries_at_once() {
+    status = 404;
+    serviceAttempts(1);
+    TEST_ASSERT_TRUE(LeaderboardStream::isUnsupported());
+    
+    // Те саме робить NetworkWorker::applyConfig() на BACKEND_CHANGED
+    LeaderboardStream::reset();
+    TEST_ASSERT_FALSE(LeaderboardStream::isUnsupported());
+    TEST_ASSERT_EQUAL(1, serviceAttempts(1));
+}
+
+int main(int argc, char** argv) {
+    startServer();
+    ConfigManager::initialize();
+    ConfigManager::API_BASE_URL = baseUrl;
+    ConfigManager::currentMode = ConfigManager::DASHBOARD_MODE;
+    ConfigManager::updateMode = ConfigManager::STREAM_UPDATES;
+    
+    WiFiManager::begin();
+    unsigned long start = millis();
+    while (!WiFiManager::isConnected() && millis() - start < WIFI_WAIT_MS) delay(1);
+    
+    UNITY_BEGIN();
+    RUN_TEST(test_missing_endpoint_stops_retries);
+    RUN_TEST(test_not_implemented_stops_retries);
+    RUN_TEST(test_server_error_backs_off);
+    RUN_TEST(test_backend_change_retries_at_once);
+    return UNITY_END();
+}
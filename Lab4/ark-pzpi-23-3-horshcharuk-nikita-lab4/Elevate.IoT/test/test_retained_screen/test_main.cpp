@@ -0,0 +1,153 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "display.h"
+#include "modules/retained_screen.h"
+#include "modules/led_display.h"
+
+// ============================================================================
+// RetainedScreen проти класичного виводу GFX
+// ============================================================================
+// Той самий рядок малюється через display.print() і через RetainedScreen,
+// після чого кадрові буфери порівнюються попіксельно
+namespace {
+    const int16_t TEXT_X = 10;
+    const int16_t TEXT_Y = 20;
+    const uint16_t TEXT_COLOR = ILI9341_WHITE;
+    const int CODES_PER_LINE = 48; // рядок уміщається в ширину без переносу
+    
+    // Друкований ASCII, керуючі коди та верхня половина CP437
+    const char MIXED_TEXT[] = "Elevate 42% ~\x01\x1F\x7F\x80\xB0\xDB\xFE";
+    
+    struct Frame {
+        std::vector<uint16_t> pixels;
+        uint32_t windows;
+    };
+    
+    Frame snapshot(uint32_t windowsBefore) {
+        Frame frame;
+        frame.windows = display.getWindowCount() - windowsBefore;
+        for (int16_t y = 0; y < display.height(); y++) {
+            for (int16_t x = 0; x < display.width(); x++) frame.pixels.push_back(display.getPixel(x, y));
+        }
+        return frame;
+    }
+    
+    Frame drawClassic(const char* text, uint8_t size) {
+        display.fillScreen(ILI9341_BLACK);
+        uint32_t windowsBefore = display.getWindowCount();
+        display.setTextSize(size);
+        display.setTextColor(TEXT_COLOR, ILI9341_BLACK);
+        display.setCursor(TEXT_X, TEXT_Y);
+        display.print(text);
+        return snapshot(windowsBefore);
+    }
+    
+    Frame drawRetained(const char* text, uint8_t size) {
+        RetainedScreen::invalidate();
+        RetainedScreen::beginFrame(RetainedScreen::STATUS_SCREEN);
+        uint32_t windowsBefore = display.getWindowCount();
+        RetainedScreen::drawText(0, TEXT_X, TEXT_Y, size, TEXT_COLOR, text);
+        RetainedScreen::endFrame();
+        return snapshot(windowsBefore);
+    }
+    
+    void assertSamePixels(const char* text, uint8_t size) {
+        Frame classic = drawClassic(text, size);
+        Frame retained = drawRetained(text, size);
+        TEST_ASSERT_TRUE(classic.pixels == retained.pixels);
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+// Кожен рядок профілю — одне вікно; порожні рядки нічого не шлють
+void test_profile_frame_sends_one_window_per_line() {
+#ifndef ELEVATE_CANVAS_RENDER
+    RetainedScreen::setGlyphAtlas(true);
+#endif
+    ScanResult profile;
+    profile.userId = Users::USER1_ID;
+    profile.fullName = Users::USER1_NAME;
+    profile.teamPoints = 120;
+    profile.teamLevelName = "Bronze";
+    profile.success = true;
+    
+    RetainedScreen::invalidate();
+    uint32_t windowsBefore = display.getWindowCount();
+    LedDisplay::showUserProfile(profile);
+    TEST_ASSERT_EQUAL(1 + 4, display.getWindowCount() - windowsBefore);
+    
+    // Наступний кадр того ж екрана шле лише змінений рядок
+    profile.teamPoints = 125;
+    windowsBefore = display.getWindowCount();
+    uint64_t pixelsBefore = display.getPixelCount();
+    LedDisplay::showUserProfile(profile);
+    TEST_ASSERT_EQUAL(1, display.getWindowCount() - windowsBefore);
+    TEST_ASSERT_EQUAL(RetainedScreen::getLastFramePixels(), display.getPixelCount() - pixelsBefore);
+}
+
+#ifdef ELEVATE_CANVAS_RENDER
+void test_canvas_matches_classic() {
+    assertSamePixels(MIXED_TEXT, 1);
+    assertSamePixels(MIXED_TEXT, 2);
+}
+
+void test_canvas_sends_one_window_per_slot() {
+    Frame classic = drawClassic(MIXED_TEXT, 2);
+    Frame canvas = drawRetained(MIXED_TEXT, 2);
+    TEST_ASSERT_EQUAL(1, canvas.windows);
+    TEST_ASSERT_LESS_THAN(classic.windows, canvas.windows);
+}
+#else
+void test_atlas_matches_classic() {
+    RetainedScreen::setGlyphAtlas(true);
+    assertSamePixels(MIXED_TEXT, 1);
+    assertSamePixels(MIXED_TEXT, 2);
+}
+
+// Атлас покриває всі 256 кодів, як і шрифт, з якого він зібраний
+void test_atlas_matches_classic_for_every_code() {
+    RetainedScreen::setGlyphAtlas(true);
+    char text[CODES_PER_LINE + 1];
+    for (int first = 1; first < 256; first += CODES_PER_LINE) {
+        int length = 0;
+        for (int code = first; code < first + CODES_PER_LINE && code < 256; code++) {
+            if (code != '\n' && code != '\r') text[length++] = (char)code;
+        }
+        text[length] = '\0';
+        assertSamePixels(text, 1);
+    }
+}
+
+void test_atlas_sends_one_window_per_slot() {
+    RetainedScreen::setGlyphAtlas(false);
+    Frame direct = drawRetained(MIXED_TEXT, 2);
+    RetainedScreen::setGlyphAtlas(true);
+    Frame atlas = drawRetained(MIXED_TEXT, 2);
+    
+    TEST_ASSERT_TRUE(direct.pixels == atlas.pixels);
+    TEST_ASSERT_EQUAL(1, atlas.windows);
+    TEST_ASSERT_LESS_THAN(direct.windows, atlas.windows);
+}
+#endif
+
+int main(int argc, char** argv) {
+    display.begin();
+    display.setRotation(1);
+    LedDisplay::setDisplayInitialized(true);
+    
+    UNITY_BEGIN();
+    RUN_TEST(test_profile_frame_sends_one_window_per_line);
+#ifdef ELEVATE_CANVAS_RENDER
+    RUN_TEST(test_canvas_matches_classic);
+    RUN_TEST(test_canvas_sends_one_window_per_slot);
+#else
+    RUN_TEST(test_atlas_matches_classic);
+    RUN_TEST(test_atlas_matches_classic_for_every_code);
+    RUN_TEST(test_atlas_sends_one_window_per_slot);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+"""
+Локальна заміна бекенду для env:native та перевірки режиму STREAM_UPDATES.
+
+Віддає:
+  POST /api/iot/scan               — профіль користувача, бали команди
+                                     зростають з кожним скануванням
+  GET  /api/iot/cards/<uid>        — {"userId": n} або 404 для невідомої
+                                     картки
+  GET  /api/iot/leaderboard        — JSON-масив (опитування) з ETag
+  GET  /api/iot/leaderboard/stream — Server-Sent Events: snapshot при
+                                     підключенні, далі події entry зі
+                                     зміною балів та heartbeat-коментарі
+
+Для навантажувальних прогонів (tools/load_test.py) відповіді на scan та
+leaderboard можна погіршити: затримка, 503, перенаправлення 307 на ту ж
+адресу та відповідь, що не встигає до тайм-ауту клієнта.
+
+Використання:
+  python tools/backend_stub.py [--port 5181] [--interval 3]
+      [--latency-ms 0] [--jitter-ms 0] [--error-rate 0] [--redirect-rate 0]
+      [--timeout-rate 0] [--timeout-ms 12000] [--seed n] [--quiet]
+env:native уже вказує на 127.0.0.1:5181. Для пристрою вкажіть
+Config::API_BASE_URL на цей хост; для потоку увімкніть
+Config::LEADERBOARD_STREAM. Для перевірки переходу на опитування
+зупиніть сервер: пристрій повернеться до запитів /api/iot/leaderboard.
+"""
+import argparse
+import hashlib
+import json
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+HEARTBEAT_SECONDS = 15
+REDIRECT_MARKER = "redirected=1"
+
+lock = threading.Lock()
+players = [
+    {"userId": 1, "fullName": "User 1", "teamPoints": 120, "teamLevel": "Silver"},
+    {"userId": 2, "fullName": "User 2", "teamPoints": 95, "teamLevel": "Bronze"},
+    {"userId": 3, "fullName": "User 3", "teamPoints": 80, "teamLevel": "Bronze"},
+    {"userId": 4, "fullName": "User 4", "teamPoints": 60, "teamLevel": "Bronze"},
+    {"userId": 5, "fullName": "User 5", "teamPoints": 40, "teamLevel": "Bronze"},
+]
+
+
+cards = {
+    "04A1B2C3": 1,
+    "04D4E5F6": 2,
+    "04172839": 3,
+}
+badges = ["First Scan", "Early Bird", "Team Player"]
+
+
+class Faults:
+    """Параметри погіршення відповідей; частки — від 0 до 1."""
+
+    def __init__(self, latency_ms=0, jitter_ms=0, error_rate=0.0, redirect_rate=0.0,
+                 timeout_rate=0.0, timeout_ms=12000, seed=None):
+        self.latency_ms = latency_ms
+        self.jitter_ms = jitter_ms
+        self.error_rate = error_rate
+        self.redirect_rate = redirect_rate
+        self.timeout_rate = timeout_rate
+        self.timeout_ms = timeout_ms
+        self.random = random.Random(seed)
+
+    def pick(self):
+        """Один розіграш на запит: 'timeout', 'error', 'redirect' або None."""
+        with lock:
+            roll = self.random.random()
+            delay = self.latency_ms + self.random.uniform(0, self.jitter_ms)
+        for name, rate in (("timeout", self.timeout_rate), ("error", self.error_rate),
+                           ("redirect", self.redirect_rate)):
+            if roll < rate:
+                return name, delay
+            roll -= rate
+        return None, delay
+
+
+initial_points = {p["userId"]: p["teamPoints"] for p in players}
+stats = {}
+
+
+def count(key):
+    with lock:
+        stats[key] = stats.get(key, 0) + 1
+
+
+def reset():
+    """Початкові бали та порожні лічильники — для повторних прогонів."""
+    with lock:
+        for player in players:
+            player["teamPoints"] = initial_points[player["userId"]]
+        stats.clear()
+
+
+def ranked():
+    rows = sorted(players, key=lambda p: -p["teamPoints"])
+    return [dict(row, rank=i + 1) for i, row in enumerate(rows)]
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    interval = 3.0
+    faults = Faults()
+    quiet = False
+
+    def do_GET(self):
+        path = self.path.split("?", 1)[0]
+        if path == "/api/iot/leaderboard":
+            if not self.inject_fault("leaderboard"):
+                self.send_leaderboard()
+        elif path == "/api/iot/leaderboard/stream":
+            self.send_stream()
+        elif path.startswith("/api/iot/cards/"):
+            self.send_card(path[len("/api/iot/cards/"):])
+        else:
+            self.send_json(404, {"message": "Not found"})
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", 0))
+        body = self.rfile.read(length)
+        if self.path.split("?", 1)[0] != "/api/iot/scan":
+            self.send_json(404, {"message": "Not found"})
+            return
+        if self.inject_fault("scan"):
+            return
+
+        try:
+            user_id = int(json.loads(body)["userId"])
+        except (ValueError, KeyError, TypeError):
+            self.send_json(400, {"message": "Invalid scan"})
+            return
+
+        with lock:
+            player = next((p for p in players if p["userId"] == user_id), None)
+            if player is None:
+                self.send_json(404, {"message": "Unknown user"})
+                return
+            player["teamPoints"] += 5
+            profile = {
+                "userId": user_id,
+                "teamId": 1,
+                "fullName": player["fullName"],
+                "teamPoints": player["teamPoints"],
+                "teamLevelName": player["teamLevel"],
+                "recentBadges": badges,
+            }
+        self.send_json(200, profile)
+
+    def inject_fault(self, endpoint):
+        """Затримує відповідь і, можливо, підміняє її; True — відповідь уже надіслана."""
+        count(endpoint)
+        fault, delay = self.faults.pick()
+        if fault == "redirect" and REDIRECT_MARKER in self.path:
+            fault = None  # повторний запит після 307 обслуговується нормально
+        if delay > 0:
+            time.sleep(delay / 1000.0)
+
+        if fault == "timeout":
+            count(endpoint + ".timeout")
+            time.sleep(self.faults.timeout_ms / 1000.0)
+            self.close_connection = True
+            return True
+        if fault == "error":
+            count(endpoint + ".error")
+            self.send_json(503, {"message": "Service unavailable"})
+            return True
+        if fault == "redirect":
+            count(endpoint + ".redirect")
+            separator = "&" if "?" in self.path else "?"
+            self.send_response(307)
+            self.send_header("Location", "http://%s%s%s%s" % (
+                self.headers.get("Host", "127.0.0.1"), self.path, separator, REDIRECT_MARKER))
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return True
+        return False
+
+    def send_json(self, status, payload, etag=None):
+        body = json.dumps(payload).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        if etag:
+            self.send_header("ETag", etag)
+        self.end_headers()
+        self.wfile.write(body)
+
+    def send_leaderboard(self):
+        with lock:
+            rows = ranked()
+        etag = '"%s"' % hashlib.sha1(json.dumps(rows).encode()).hexdigest()[:16]
+        if self.headers.get("If-None-Match") == etag:
+            self.send_response(304)
+            self.send_header("ETag", etag)
+            self.end_headers()
+            return
+        self.send_json(200, rows, etag)
+
+    def send_card(self, uid):
+        user_id = cards.get(uid.upper())
+        if user_id is None:
+            self.send_json(404, {"message": "Unknown card"})
+        else:
+            self.send_json(200, {"userId": user_id})
+
+    def send_event(self, name, payload):
+        data = "event: %s\ndata: %s\n\n" % (name, json.dumps(payload))
+        self.wfile.write(data.encode())
+        self.wfile.flush()
+
+    def send_stream(self):
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Connection", "close")
+        self.end_headers()
+        self.close_connection = True
+
+        try:
+            with lock:
+                before = ranked()
+            self.send_event("snapshot", before)
+
+            last_heartbeat = time.time()
+            while True:
+                time.sleep(self.interval)
+                with lock:
+                    random.choice(players)["teamPoints"] += random.randint(1, 10)
+                    after = ranked()
+
+                # Лише змінені рядки, як і надсилатиме бекенд
+                for old, new in zip(before, after):
+                    if old != new:
+                        self.send_event("entry", new)
+                before = after
+
+                if time.time() - last_heartbeat >= HEARTBEAT_SECONDS:
+                    self.wfile.write(b": heartbeat\n\n")
+                    self.wfile.flush()
+                    last_heartbeat = time.time()
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+    def log_message(self, fmt, *args):
+        if not self.quiet:
+            print("%s %s" % (self.address_string(), fmt % args))
+
+
+def add_fault_arguments(parser):
+    parser.add_argument("--latency-ms", type=float, default=0)
+    parser.add_argument("--jitter-ms", type=float, default=0)
+    parser.add_argument("--error-rate", type=float, default=0.0)
+    parser.add_argument("--redirect-rate", type=float, default=0.0)
+    parser.add_argument("--timeout-rate", type=float, default=0.0)
+    parser.add_argument("--timeout-ms", type=float, default=12000,
+                        help="більше за Timing::HTTP_TIMEOUT_MS прошивки")
+    parser.add_argument("--seed", type=int, default=None)
+
+
+def faults_from_arguments(args):
+    return Faults(args.latency_ms, args.jitter_ms, args.error_rate, args.redirect_rate,
+                  args.timeout_rate, args.timeout_ms, args.seed)
+
+
+def create_server(port, faults=None, interval=3.0, quiet=False):
+    Handler.faults = faults or Faults()
+    Handler.interval = interval
+    Handler.quiet = quiet
+    return ThreadingHTTPServer(("0.0.0.0", port), Handler)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--port", type=int, default=5181)
+    parser.add_argument("--interval", type=float, default=3.0)
+    parser.add_argument("--quiet", action="store_true")
+    add_fault_arguments(parser)
+    args = parser.parse_args()
+
+    server = create_server(args.port, faults_from_arguments(args), args.interval, args.quiet)
+    print("Serving on port %d" % args.port)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Генерує src/badge_table.h — таблицю UID карток -> userId у флеш-пам'яті.
+
+Таблиця з відкритою адресацією (лінійне зондування), ключ — довжина UID
+у старшому байті та до 7 байтів UID. Хеш і формат ключа мають збігатися
+з BadgeDirectory::makeKey / BadgeDirectory::hashKey.
+
+Використання: python tools/gen_badge_table.py tools/badges.csv src/badge_table.h
+"""
+import csv
+import sys
+
+MASK64 = (1 << 64) - 1
+MAX_UID_LENGTH = 7
+MAX_LOAD_PERCENT = 75
+
+
+def make_key(uid):
+    if not 0 < len(uid) <= MAX_UID_LENGTH:
+        raise ValueError("UID must be 1..%d bytes: %s" % (MAX_UID_LENGTH, uid.hex()))
+    key = len(uid) << 56
+    for i, b in enumerate(uid):
+        key |= b << (8 * (6 - i))
+    return key
+
+
+def hash_key(key):
+    key ^= key >> 33
+    key = (key * 0xFF51AFD7ED558CCD) & MASK64
+    key ^= key >> 33
+    key = (key * 0xC4CEB9FE1A85EC53) & MASK64
+    key ^= key >> 33
+    return key
+
+
+def read_cards(path):
+    cards = {}
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            if not row or row[0].lstrip().startswith("#"):
+                continue
+            key = make_key(bytes.fromhex(row[0].strip()))
+            user_id = int(row[1])
+            if key in cards and cards[key] != user_id:
+                raise ValueError("Duplicate UID with different users: " + row[0])
+            cards[key] = user_id
+    return cards
+
+
+def build_table(cards):
+    slot_count = 8
+    while len(cards) * 100 > slot_count * MAX_LOAD_PERCENT:
+        slot_count *= 2
+
+    keys = [0] * slot_count
+    user_ids = [0] * slot_count
+    max_probe = 0
+    for key, user_id in sorted(cards.items()):
+        index = hash_key(key) & (slot_count - 1)
+        probe = 0
+        while keys[index] != 0:
+            index = (index + 1) & (slot_count - 1)
+            probe += 1
+        keys[index] = key
+        user_ids[index] = user_id
+        max_probe = max(max_probe, probe)
+    return keys, user_ids, max_probe
+
+
+def write_header(path, cards, keys, user_ids, max_probe):
+    def rows(values, fmt, per_line):
+        lines = []
+        for i in range(0, len(values), per_line):
+            lines.append("        " + ", ".join(fmt % v for v in values[i:i + per_line]) + ",")
+        return "\n".join(lines)
+
+    with open(path, "w", newline="\n") as f:
+        f.write("#pragma once\n\n")
+        f.write("#include <stdint.h>\n\n")
+        f.write("// ============================================================================\n")
+        f.write("// BadgeTable - Згенеровано tools/gen_badge_table.py, не редагувати вручну\n")
+        f.write("// ============================================================================\n")
+        f.write("namespace BadgeTable {\n")
+        f.write("    constexpr unsigned int CARD_COUNT = %d;\n" % len(cards))
+        f.write("    constexpr unsigned int SLOT_COUNT = %d;\n" % len(keys))
+        f.write("    constexpr unsigned int MAX_PROBE = %d;\n\n" % max_probe)
+        f.write("    const uint64_t KEYS[SLOT_COUNT] = {\n")
+        f.write(rows(keys, "0x%016XULL", 4) + "\n    };\n\n")
+        f.write("    const uint32_t USER_IDS[SLOT_COUNT] = {\n")
+        f.write(rows(user_ids, "%d", 8) + "\n    };\n")
+        f.write("}\n")
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    cards = read_cards(sys.argv[1])
+    keys, user_ids, max_probe = build_table(cards)
+    write_header(sys.argv[2], cards, keys, user_ids, max_probe)
+    print("%d cards, %d slots, max probe %d, %d bytes" %
+          (len(cards), len(keys), max_probe, len(keys) * 12))
+
+
+if __name__ == "__main__":
+    main()
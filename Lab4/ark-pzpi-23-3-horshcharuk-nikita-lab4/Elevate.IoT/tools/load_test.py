@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""
+Навантажувальний прогін прошивки env:native на сплесках сканувань.
+
+Генерує сценарій натискань (сплески з заданою частотою, як на зміні
+змін) або бере готовий, піднімає backend_stub із заданими збоями і
+проганяє на ньому кожну збірку з тим самим сценарієм та зерном. Справжні
+CoreLogic, NetworkWorker і ApiClient обробляють натискання; з
+підсумкового звіту [status]/[latency] береться:
+
+  throughput  — завершених сканувань за секунду від першого натискання
+                до останнього результату на екрані
+  p50/p95/p99 — затримка "переривання -> результат на екрані" (верхня
+                межа кошика гістограми SCAN_STAGE)
+  dropped     — натискання без результату на екрані та причини:
+                брязкіт, переповнення кільця, переповнення черги задачі
+  пам'ять     — мінімум вільної купи, пік пулу JSON, піки черг
+  ядра        — частка часу, коли ядро 0 (мережа) і ядро 1 (UI) не в idle
+  живлення    — частка часу в light sleep, затримка "пробудження -> запит",
+                оцінка середнього струму
+
+Використання:
+  python tools/load_test.py --env native --env native-canvas \\
+      --rate 40 --bursts 3 --latency-ms 150 --jitter-ms 300 \\
+      --error-rate 0.05 --redirect-rate 0.05 --timeout-rate 0.02
+  python tools/load_test.py --program .pio/build/native/program --no-build \\
+      --timeline presses.txt
+"""
+import argparse
+import json
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+import threading
+
+import backend_stub
+
+# Мають збігатися з Hardware:: у src/constants.h
+USER_BUTTONS = (32, 33, 25)
+LEADERBOARD_BUTTON = 26
+
+START_MS = 2000          # перше натискання після старту прошивки
+SETTLE_MS = 15000        # тайм-аут HTTP прошивки + запас на журнал
+PROCESS_TIMEOUT_S = 600
+
+STATUS_PATTERN = re.compile(r"([\w.]+)=([^\s]+)")
+
+
+def generate_timeline(args):
+    """Сплески натискань із пуассонівськими інтервалами між ними."""
+    rng = random.Random(args.seed)
+    lines = []
+    at = START_MS
+    presses = 0
+    for _ in range(args.bursts):
+        end = at + args.burst_seconds * 1000
+        mean_gap_ms = 60000.0 / args.rate
+        while True:
+            at += max(1, int(rng.expovariate(1.0 / mean_gap_ms)))
+            if at >= end:
+                break
+            presses += 1
+            if args.leaderboard_every and presses % args.leaderboard_every == 0:
+                lines.append("%d press %d" % (at, LEADERBOARD_BUTTON))
+            else:
+                lines.append("%d press %d" % (at, rng.choice(USER_BUTTONS)))
+        at = end + args.gap_seconds * 1000
+    return lines
+
+
+def timeline_bounds(lines):
+    """Кількість натискань кнопок користувачів, перше з них і остання подія."""
+    presses, first, last = 0, None, 0
+    for line in lines:
+        fields = line.split("#", 1)[0].split()
+        if not fields:
+            continue
+        at = int(fields[0])
+        last = max(last, at)
+        if len(fields) >= 3 and fields[1] == "press" and int(fields[2]) in USER_BUTTONS:
+            presses += 1
+            first = at if first is None else min(first, at)
+    return presses, first or 0, last
+
+
+def parse_number(text):
+    match = re.match(r"-?\d+", text)
+    return int(match.group(0)) if match else text
+
+
+def parse_report(output):
+    """Останні значення [status] та гістограми [latency] з виводу прогону."""
+    status, latency = {}, {}
+    for line in output.splitlines():
+        if line.startswith("[status]"):
+            for key, value in STATUS_PATTERN.findall(line):
+                status[key] = value
+        elif line.startswith("[latency] stage="):
+            fields = dict(STATUS_PATTERN.findall(line))
+            latency[fields["stage"]] = {
+                "n": int(fields["n"]),
+                "max": int(fields["max"]),
+                "buckets": [int(b) for b in fields["buckets"].split(",")],
+            }
+    return status, latency
+
+
+def percentile_ms(histogram, percent):
+    if histogram is None or histogram["n"] == 0:
+        return None
+    target = (histogram["n"] * percent + 99) // 100
+    seen = 0
+    for i, bucket in enumerate(histogram["buckets"]):
+        seen += bucket
+        if seen >= target:
+            return min((2 << i) - 1, histogram["max"]) / 1000.0
+    return histogram["max"] / 1000.0
+
+
+def summarize(status, latency, presses, first_press_ms, server_stats):
+    value = lambda key: parse_number(status.get(key, "0"))
+    completed = value("scan.ok") + value("scan.failed")
+    window_ms = value("scan.last") - first_press_ms
+    scan = latency.get("scan")
+    pool = status.get("json.pool.peak", "0/0").split("/")
+    return {
+        "presses": presses,
+        "scans.ok": value("scan.ok"),
+        "scans.failed": value("scan.failed"),
+        "throughput/s": round(completed * 1000.0 / window_ms, 2) if window_ms > 0 else 0,
+        "p50.ms": percentile_ms(scan, 50),
+        "p95.ms": percentile_ms(scan, 95),
+        "p99.ms": percentile_ms(scan, 99),
+        "max.ms": scan["max"] / 1000.0 if scan else None,
+        "dropped": max(0, presses - completed),
+        "dropped.debounce": value("input.coalesced"),
+        "dropped.ring": value("input.dropped"),
+        "dropped.queue": value("net.dropped"),
+        "journaled": value("journal.appended"),
+        "heap.min.free": value("heap.min"),
+        "json.pool.peak": parse_number(pool[0]),
+        "input.peak": value("input.peak"),
+        "net.queue.peak": value("net.queue.peak"),
+        "net.stalls": value("net.stalls"),
+        "core0.busy%": value("core0.busy"),
+        "core1.busy%": value("core1.busy"),
+        "sleep%": value("power.sleep"),
+        "wake.p99.ms": percentile_ms(latency.get("wake"), 99),
+        "power.avg.uA": value("power.avg.est"),
+        "stub.requests": server_stats.get("scan", 0) + server_stats.get("leaderboard", 0),
+        "stub.faults": sum(v for k, v in server_stats.items() if "." in k),
+    }
+
+
+def program_path(env):
+    return os.path.join(".pio", "build", env, "program")
+
+
+def build(env):
+    subprocess.run(["pio", "run", "-e", env], check=True)
+    return program_path(env)
+
+
+def run_build(name, program, script_path, args, presses, first_press_ms):
+    # Бекенд свіжий для кожної збірки: ті самі бали й ті самі розіграші збоїв
+    backend_stub.reset()
+    server = backend_stub.create_server(args.port, backend_stub.faults_from_arguments(args), quiet=True)
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+
+    try:
+        with tempfile.TemporaryDirectory(prefix="elevate-load-") as fs_root:
+            result = subprocess.run(
+                [program, "--script", script_path, "--seed", str(args.seed),
+                 "--fs", fs_root, "--run-ms", str(args.run_ms)],
+                stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True,
+                timeout=PROCESS_TIMEOUT_S)
+    finally:
+        server.shutdown()
+        server.server_close()
+
+    if args.verbose:
+        sys.stdout.write(result.stdout)
+    if result.returncode != 0:
+        raise SystemExit("%s exited with %d" % (name, result.returncode))
+
+    status, latency = parse_report(result.stdout)
+    if not status:
+        raise SystemExit("%s printed no [status] report" % name)
+    return summarize(status, latency, presses, first_press_ms, dict(backend_stub.stats))
+
+
+def print_table(results):
+    names = list(results)
+    keys = list(next(iter(results.values())))
+    width = max(len(k) for k in keys)
+    columns = [max(len(n), 10) for n in names]
+    print("%-*s  %s" % (width, "", "  ".join("%*s" % (c, n) for c, n in zip(columns, names))))
+    for key in keys:
+        cells = []
+        for column, name in zip(columns, names):
+            value = results[name][key]
+            cells.append("%*s" % (column, "-" if value is None else value))
+        print("%-*s  %s" % (width, key, "  ".join(cells)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--env", action="append", default=[],
+                        help="середовище platformio; можна кілька")
+    parser.add_argument("--program", action="append", default=[],
+                        help="готовий бінарник native; можна кілька")
+    parser.add_argument("--no-build", action="store_true")
+    parser.add_argument("--timeline", help="готовий сценарій замість згенерованого")
+    parser.add_argument("--rate", type=float, default=40, help="натискань за хвилину у сплеску")
+    parser.add_argument("--bursts", type=int, default=3)
+    parser.add_argument("--burst-seconds", type=int, default=30)
+    parser.add_argument("--gap-seconds", type=int, default=20)
+    parser.add_argument("--leaderboard-every", type=int, default=0,
+                        help="кожне N-те натискання — кнопка лідерборду")
+    parser.add_argument("--port", type=int, default=5181)
+    parser.add_argument("--json", help="зберегти результати у файл")
+    parser.add_argument("--verbose", action="store_true", help="показати вивід прошивки")
+    backend_stub.add_fault_arguments(parser)
+    args = parser.parse_args()
+    if args.seed is None:
+        args.seed = 1
+
+    if args.timeline:
+        with open(args.timeline) as timeline:
+            lines = timeline.read().splitlines()
+    else:
+        lines = generate_timeline(args)
+    presses, first_press_ms, last_ms = timeline_bounds(lines)
+    args.run_ms = last_ms + SETTLE_MS
+
+    builds = [(env, None) for env in args.env] + [(program, program) for program in args.program]
+    if not builds:
+        builds = [("native", None)]
+
+    results = {}
+    with tempfile.NamedTemporaryFile("w", suffix=".txt", prefix="presses-") as script:
+        script.write("\n".join(lines) + "\n")
+        script.flush()
+        for name, program in builds:
+            if program is None:
+                program = program_path(name) if args.no_build else build(name)
+            print("running %s: %d presses over %.1f s" % (name, presses, args.run_ms / 1000.0),
+                  file=sys.stderr)
+            results[name] = run_build(name, program, script.name, args, presses, first_press_ms)
+
+    print_table(results)
+    if args.json:
+        with open(args.json, "w") as output:
+            json.dump(results, output, indent=2)
+
+
+if __name__ == "__main__":
+    main()